@@ -0,0 +1,81 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <string>
+#include <vector>
+
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/ArrayView.hpp"
+#include "Benchmark.hpp"
+
+using buffers::AlignMemory;
+using buffers::ArrayView;
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+
+/**
+ * Size of packed records and speed of their decoding for every mode of AlignMemory.
+ * Record mixes small and large scalars, string and array, as typical message
+ */
+
+static const size_t kNumRecords = 100000;
+
+static bool putRecord(HeapPackBuffer & _buffer, const uint32_t _id,
+                      const std::string & _name, const std::vector<float> & _values) {
+  return _buffer.put<uint8_t>(static_cast<uint8_t>(_id)) &&
+         _buffer.put<uint16_t>(static_cast<uint16_t>(_id)) &&
+         _buffer.put<uint32_t>(_id) &&
+         _buffer.put<uint8_t>(1) &&
+         _buffer.put<uint64_t>(_id * 3ull) &&
+         _buffer.put<double>(_id * 0.5) &&
+         _buffer.put(_name) &&
+         _buffer.put(_values);
+}
+
+static uint64_t getRecord(UnpackBuffer & _buffer) {
+  uint64_t sum = _buffer.get<uint8_t>();
+  sum += _buffer.get<uint16_t>();
+  sum += _buffer.get<uint32_t>();
+  sum += _buffer.get<uint8_t>();
+  sum += _buffer.get<uint64_t>();
+  sum += static_cast<uint64_t>(_buffer.get<double>());
+  sum += std::strlen(_buffer.get<const char *>());
+  sum += static_cast<uint64_t>(_buffer.get<ArrayView<float>>().data()[7]);
+  return sum;
+}
+
+int main() {
+  const std::string kName = "record name";
+  const std::vector<float> kValues(8, 1.5f);
+  const struct {
+    AlignMemory alignment;
+    const char * name;
+  } kModes[] = {
+      {AlignMemory::Natural, "Natural"},
+      {AlignMemory::Bits_8, "Bits_8"},
+      {AlignMemory::Bits_16, "Bits_16"},
+      {AlignMemory::Bits_32, "Bits_32"},
+      {AlignMemory::Bits_64, "Bits_64"},
+  };
+  for (const auto & kMode : kModes) {
+    HeapPackBuffer buffer(kNumRecords * 256, kMode.alignment);
+    for (uint32_t i = 0; i < kNumRecords; ++i) {
+      putRecord(buffer, i, kName, kValues);
+    }
+    const double kSeconds = benchmarks::measure([&]() {
+      UnpackBuffer unbuffer(buffer.getData(), buffer.getDataSize(), kMode.alignment);
+      uint64_t sum = 0;
+      for (size_t i = 0; i < kNumRecords; ++i) {
+        sum += getRecord(unbuffer);
+      }
+      benchmarks::doNotOptimize(sum);
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "decode %s, %.1f bytes per record",
+                  kMode.name, static_cast<double>(buffer.getDataSize()) / kNumRecords);
+    benchmarks::report(name, kSeconds, static_cast<double>(buffer.getDataSize()));
+  }
+  return 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file Benchmark.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains helpers for timing of benchmarks
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_BENCHMARK_HPP
+#define BUFFERS_BENCHMARK_HPP
+
+#include <stdint.h>
+#include <cstdio>
+#include <chrono>
+#include <limits>
+
+namespace benchmarks {
+  /**
+   * Method for preventing compiler from optimizing away of computed value
+   * @param _value Value that should be computed
+   */
+  template <typename T>
+  inline void doNotOptimize(const T & _value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(_value) : "memory");
+#else
+    static volatile const T * pSink;
+    pSink = &_value;
+#endif
+  }
+
+  /**
+   * Method for measuring the best time of function over several runs
+   * @param _function Function for measuring
+   * @param _numRuns Number of runs
+   * @return The best time of one run in seconds
+   */
+  template <typename TFunction>
+  double measure(TFunction _function, const size_t _numRuns = 5) {
+    double best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < _numRuns; ++i) {
+      const auto kStart = std::chrono::steady_clock::now();
+      _function();
+      const std::chrono::duration<double> kElapsed = std::chrono::steady_clock::now() - kStart;
+      if (kElapsed.count() < best) {
+        best = kElapsed.count();
+      }
+    }
+    return best;
+  }
+
+  /**
+   * Method for printing time and throughput of benchmark
+   * @param _name Name of benchmark
+   * @param _seconds Time of one run
+   * @param _bytes Number of bytes processed by one run
+   */
+  inline void report(const char * _name, const double _seconds, const double _bytes) {
+    std::printf("%-48s %10.3f ms %10.1f MB/s\n", _name, _seconds * 1e3, _bytes / _seconds / (1024.0 * 1024.0));
+  }
+}
+
+#endif //BUFFERS_BENCHMARK_HPP
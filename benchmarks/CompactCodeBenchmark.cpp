@@ -0,0 +1,202 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "Benchmark.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+
+/**
+ * Size of code and L1 instruction cache misses of program that packs and unpacks
+ * many different container types, as service with many message types.
+ * Build it with and without PUB_COMPACT_CODE and compare the results
+ */
+
+#if defined(__GNUC__) && defined(__linux__)
+extern "C" char __executable_start;
+extern "C" char etext;
+#endif
+
+static const size_t kNumTypes = 32;
+static const size_t kNumElements = 16;
+
+template <size_t N>
+struct Tagged {
+  uint64_t value;
+
+  bool operator<(const Tagged & _other) const {
+    return value < _other.value;
+  }
+};
+
+template <size_t N>
+struct Messages {
+  std::map<Tagged<N>, std::string> map0;
+  std::list<Tagged<N>> list0;
+  std::set<Tagged<N>> set0;
+  std::unordered_map<std::string, Tagged<N>> hashMap0;
+
+  Messages() {
+    for (uint64_t i = 0; i < kNumElements; ++i) {
+      map0.emplace(Tagged<N>{i * N}, "value " + std::to_string(i));
+      list0.push_back(Tagged<N>{i + N});
+      set0.insert(Tagged<N>{i ^ N});
+      hashMap0.emplace("key " + std::to_string(i), Tagged<N>{i});
+    }
+  }
+
+  bool pack(HeapPackBuffer & _buffer) const {
+    _buffer.reset();
+    return _buffer.put(map0) && _buffer.put(list0) && _buffer.put(set0) && _buffer.put(hashMap0);
+  }
+
+  size_t roundTrip(HeapPackBuffer & _buffer) const {
+    pack(_buffer);
+    UnpackBuffer unbuffer(_buffer.getData(), _buffer.getDataSize());
+    return unbuffer.get<std::map<Tagged<N>, std::string>>().size() +
+           unbuffer.get<std::list<Tagged<N>>>().size() +
+           unbuffer.get<std::set<Tagged<N>>>().size() +
+           unbuffer.get<std::unordered_map<std::string, Tagged<N>>>().size();
+  }
+};
+
+template <size_t N>
+struct AllMessages : AllMessages<N - 1> {
+  Messages<N - 1> messages;
+
+  bool pack(HeapPackBuffer & _buffer) const {
+    return AllMessages<N - 1>::pack(_buffer) && messages.pack(_buffer);
+  }
+
+  size_t roundTrip(HeapPackBuffer & _buffer) const {
+    return AllMessages<N - 1>::roundTrip(_buffer) + messages.roundTrip(_buffer);
+  }
+};
+
+template <>
+struct AllMessages<0> {
+  bool pack(HeapPackBuffer &) const {
+    return true;
+  }
+
+  size_t roundTrip(HeapPackBuffer &) const {
+    return 0;
+  }
+};
+
+/**
+ * Counter of L1 instruction cache misses of this process, if it is available
+ */
+class ICacheMisses {
+ public:
+  ICacheMisses()
+      : fd_{-1} {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_L1I |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  ~ICacheMisses() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+#endif
+  }
+
+  bool isAvailable() const {
+    return fd_ >= 0;
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  uint64_t stop() {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+        count = 0;
+      }
+    }
+#endif
+    return count;
+  }
+
+ private:
+  int fd_;
+};
+
+int main() {
+#ifdef PUB_COMPACT_CODE
+  std::printf("mode: PUB_COMPACT_CODE\n");
+#else
+  std::printf("mode: default\n");
+#endif
+#if defined(__GNUC__) && defined(__linux__)
+  std::printf("size of code: %zu KB\n", static_cast<size_t>(&etext - &__executable_start) / 1024);
+#endif
+  const AllMessages<kNumTypes> kMessages;
+  HeapPackBuffer buffer(64 * 1024);
+  const size_t kNumRounds = 2000;
+  ICacheMisses iCacheMisses;
+  if (!iCacheMisses.isAvailable()) {
+    std::printf("L1 instruction cache misses: counter is not available\n");
+  }
+  iCacheMisses.start();
+  const double kPackSeconds = benchmarks::measure([&]() {
+    for (size_t i = 0; i < kNumRounds; ++i) {
+      benchmarks::doNotOptimize(kMessages.pack(buffer));
+    }
+  });
+  uint64_t misses = iCacheMisses.stop();
+  std::printf("packing of %zu message types: %.3f us\n", kNumTypes, kPackSeconds / kNumRounds * 1e6);
+  if (iCacheMisses.isAvailable()) {
+    std::printf("  L1 instruction cache misses: %.0f\n", static_cast<double>(misses) / (5 * kNumRounds));
+  }
+  iCacheMisses.start();
+  const double kRoundTripSeconds = benchmarks::measure([&]() {
+    for (size_t i = 0; i < kNumRounds; ++i) {
+      benchmarks::doNotOptimize(kMessages.roundTrip(buffer));
+    }
+  });
+  misses = iCacheMisses.stop();
+  std::printf("round trip of %zu message types: %.3f us\n", kNumTypes, kRoundTripSeconds / kNumRounds * 1e6);
+  if (iCacheMisses.isAvailable()) {
+    std::printf("  L1 instruction cache misses: %.0f\n", static_cast<double>(misses) / (5 * kNumRounds));
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#if defined(__linux__)
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <thread>
+#include <vector>
+
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/FrameForwarder.hpp"
+#include "Benchmark.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::FrameForwarder;
+
+/**
+ * Forwarding of file with frames to pipe drained by another thread:
+ * FrameForwarder (sendfile) against loop of read and write through user space buffer
+ */
+
+static const size_t kFileSize = 256 * 1024 * 1024;
+
+static int createFile(const size_t _frameSize) {
+  char path[] = "/tmp/FrameForwarderBenchmarkXXXXXX";
+  const int kFd = mkstemp(path);
+  unlink(path);
+  std::vector<uint8_t> payload(_frameSize - 2 * sizeof(size_t), 0x5A);
+  HeapPackBuffer frame(_frameSize + 64);
+  frame.put(payload.data(), payload.size());
+  HeapPackBuffer batch(1024 * 1024 + _frameSize + 64);
+  while (batch.getDataSize() + frame.getDataSize() + sizeof(size_t) <= 1024 * 1024) {
+    batch.put(frame.getData(), frame.getDataSize());
+  }
+  for (size_t written = 0; written < kFileSize; written += batch.getDataSize()) {
+    if (write(kFd, batch.getData(), batch.getDataSize()) != static_cast<ssize_t>(batch.getDataSize())) {
+      break;
+    }
+  }
+  return kFd;
+}
+
+template <typename TSend>
+static double forwardToPipe(TSend _send) {
+  int pipeFds[2];
+  if (pipe(pipeFds) != 0) {
+    return 0;
+  }
+  std::thread drain([&pipeFds]() {
+    static uint8_t sink[1024 * 1024];
+    while (read(pipeFds[0], sink, sizeof(sink)) > 0) {
+    }
+  });
+  const double kSeconds = benchmarks::measure([&]() {
+    _send(pipeFds[1]);
+  }, 1);
+  close(pipeFds[1]);
+  drain.join();
+  close(pipeFds[0]);
+  return kSeconds;
+}
+
+int main() {
+  for (size_t frameSize : {256, 4096, 65536}) {
+    const int kFd = createFile(frameSize);
+    const off_t kSize = lseek(kFd, 0, SEEK_END);
+    char name[64];
+    for (int run = 0; run < 3; ++run) {
+      std::snprintf(name, sizeof(name), "sendfile, frames of %zu bytes", frameSize);
+      benchmarks::report(name, forwardToPipe([kFd](int _outFd) {
+        FrameForwarder forwarder(kFd, _outFd);
+        benchmarks::doNotOptimize(forwarder.forward());
+      }), kSize);
+      std::snprintf(name, sizeof(name), "read/write, frames of %zu bytes", frameSize);
+      benchmarks::report(name, forwardToPipe([kFd, kSize](int _outFd) {
+        static uint8_t chunk[64 * 1024];
+        for (off_t offset = 0; offset < kSize;) {
+          const ssize_t kRead = pread(kFd, chunk, sizeof(chunk), offset);
+          if (kRead <= 0) {
+            break;
+          }
+          for (ssize_t written = 0; written < kRead;) {
+            const ssize_t kWritten = write(_outFd, chunk + written, static_cast<size_t>(kRead - written));
+            if (kWritten <= 0) {
+              return;
+            }
+            written += kWritten;
+          }
+          offset += kRead;
+        }
+      }), kSize);
+    }
+    close(kFd);
+  }
+  return 0;
+}
+#else
+#include <cstdio>
+
+int main() {
+  std::printf("FrameForwarder is supported only on Linux\n");
+  return 0;
+}
+#endif
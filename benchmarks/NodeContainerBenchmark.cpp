@@ -0,0 +1,59 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <list>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+#include "pub/HeapPackBuffer.hpp"
+#include "Benchmark.hpp"
+
+using buffers::HeapPackBuffer;
+
+/**
+ * Packing of node based containers with 10M nodes.
+ * Nodes are visited in order that does not match order of their allocation,
+ * so every node is a cache miss, as in long living containers
+ */
+
+static const size_t kNumNodes = 10 * 1000 * 1000;
+
+template <typename TContainer>
+static void packContainer(const char * _name, const TContainer & _container, const size_t _payloadSize) {
+  HeapPackBuffer buffer(_payloadSize + 64);
+  const double kSeconds = benchmarks::measure([&]() {
+    buffer.reset();
+    benchmarks::doNotOptimize(buffer.put(_container));
+  }, 3);
+  benchmarks::report(_name, kSeconds, static_cast<double>(buffer.getDataSize()));
+}
+
+int main() {
+  std::mt19937_64 random(42);
+  {
+    std::map<uint64_t, uint64_t> map0;
+    while (map0.size() < kNumNodes) {
+      map0.emplace(random(), map0.size());
+    }
+    packContainer("std::map<uint64_t, uint64_t>", map0, sizeof(size_t) + kNumNodes * 2 * sizeof(uint64_t));
+  }
+  {
+    std::unordered_map<uint64_t, uint64_t> map0;
+    map0.reserve(kNumNodes);
+    while (map0.size() < kNumNodes) {
+      map0.emplace(random(), map0.size());
+    }
+    packContainer("std::unordered_map<uint64_t, uint64_t>", map0, sizeof(size_t) + kNumNodes * 2 * sizeof(uint64_t));
+  }
+  {
+    std::list<uint64_t> list0;
+    for (size_t i = 0; i < kNumNodes; ++i) {
+      list0.push_back(random());
+    }
+    list0.sort();
+    packContainer("std::list<uint64_t>", list0, sizeof(size_t) + kNumNodes * sizeof(uint64_t));
+  }
+  return 0;
+}
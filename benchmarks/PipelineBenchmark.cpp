@@ -0,0 +1,84 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <ctime>
+#include <thread>
+
+#include "pub/Pipeline.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "Benchmark.hpp"
+
+using buffers::BufferPool;
+using buffers::HeapPackBuffer;
+using buffers::Pipeline;
+using buffers::UnpackBuffer;
+
+/**
+ * Throughput of pipeline pack -> transform -> checksum -> write with growing number of threads
+ * of the heaviest stage (transform), utilisation of every stage, and CPU time of idle pipeline
+ */
+
+static const size_t kNumMessages = 200000;
+static const size_t kMessageSize = 1024;
+
+static HeapPackBuffer * transform(HeapPackBuffer * _buffer) {
+  uint8_t * pData = const_cast<uint8_t *>(_buffer->getData());
+  for (size_t round = 0; round < 8; ++round) {
+    for (size_t i = 1; i < _buffer->getDataSize(); ++i) {
+      pData[i] = static_cast<uint8_t>(pData[i] * 31 + pData[i - 1]);
+    }
+  }
+  return _buffer;
+}
+
+static HeapPackBuffer * checksum(HeapPackBuffer * _buffer) {
+  UnpackBuffer unbuffer(_buffer->getData(), _buffer->getDataSize());
+  benchmarks::doNotOptimize(unbuffer.getHash());
+  return _buffer;
+}
+
+static HeapPackBuffer * write(HeapPackBuffer * _buffer) {
+  benchmarks::doNotOptimize(_buffer->getData()[0]);
+  return _buffer;
+}
+
+int main() {
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  const std::vector<uint8_t> kPayload(kMessageSize - sizeof(size_t), 0x5A);
+  for (size_t numThreads : {1, 2, 4}) {
+    BufferPool pool(kMessageSize + 64);
+    Pipeline pipeline(pool, 256);
+    pipeline.addStage(transform, numThreads);
+    pipeline.addStage(checksum);
+    pipeline.addStage(write);
+    pipeline.start();
+    const double kSeconds = benchmarks::measure([&]() {
+      for (size_t i = 0; i < kNumMessages; ++i) {
+        HeapPackBuffer * buffer = pipeline.acquire();
+        buffer->put(kPayload.data(), kPayload.size());
+        pipeline.submit(buffer);
+      }
+      pipeline.stop();
+    }, 1);
+    char name[64];
+    std::snprintf(name, sizeof(name), "transform on %zu threads", numThreads);
+    benchmarks::report(name, kSeconds, static_cast<double>(kNumMessages * kMessageSize));
+    std::printf("  %.0f messages/s, utilisation: transform %.2f, checksum %.2f, write %.2f\n",
+                kNumMessages / kSeconds,
+                pipeline.getUtilisation(0), pipeline.getUtilisation(1), pipeline.getUtilisation(2));
+  }
+
+  BufferPool pool(kMessageSize + 64);
+  Pipeline pipeline(pool, 256);
+  pipeline.addStage(transform, 4);
+  pipeline.addStage(checksum);
+  pipeline.addStage(write);
+  pipeline.start();
+  const std::clock_t kStart = std::clock();
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  std::printf("CPU time of idle pipeline with 6 threads during 1 s: %.3f s\n",
+              static_cast<double>(std::clock() - kStart) / CLOCKS_PER_SEC);
+  pipeline.stop();
+  return 0;
+}
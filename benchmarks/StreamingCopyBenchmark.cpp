@@ -0,0 +1,76 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "pub/CopyEngine.hpp"
+#include "Benchmark.hpp"
+
+using buffers::CopyEngine;
+
+/**
+ * Throughput of bulk copy with memcpy and with non-temporal stores,
+ * and time of the pass of neighbour over its working set right after the copy.
+ * Neighbour walks its working set in random order, so every line evicted by the copy is a miss
+ */
+
+static std::vector<uint32_t> createWalk(const size_t _numLines) {
+  std::vector<uint32_t> order(_numLines);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin() + 1, order.end(), std::mt19937(42));
+  std::vector<uint32_t> next(_numLines * 16);
+  for (size_t i = 0; i < _numLines; ++i) {
+    next[order[i] * 16] = order[(i + 1) % _numLines] * 16;
+  }
+  return next;
+}
+
+static uint32_t walk(const std::vector<uint32_t> & _next) {
+  uint32_t pos = 0;
+  for (size_t i = 0; i < _next.size() / 16; ++i) {
+    pos = _next[pos];
+  }
+  return pos;
+}
+
+int main() {
+  std::printf("streaming copy supported: %d\n", CopyEngine::isStreamingSupported());
+  for (size_t neighbourSize : {256 * 1024, 1024 * 1024}) {
+    const std::vector<uint32_t> kNeighbour = createWalk(neighbourSize / 64);
+    for (size_t copySize : {256 * 1024, 4 * 1024 * 1024, 64 * 1024 * 1024}) {
+      std::vector<uint8_t> src(copySize, 0x5A);
+      std::vector<uint8_t> dst(copySize, 0);
+      for (size_t threshold : {0, 1}) {
+        CopyEngine::setStreamingThreshold(threshold);
+        double copySeconds = 0;
+        double neighbourSeconds = 0;
+        for (size_t run = 0; run < 5; ++run) {
+          benchmarks::doNotOptimize(walk(kNeighbour));
+          const double kCopy = benchmarks::measure([&]() {
+            CopyEngine::copy(dst.data(), src.data(), copySize);
+            benchmarks::doNotOptimize(dst.data());
+          }, 1);
+          const double kNeighbour0 = benchmarks::measure([&]() {
+            benchmarks::doNotOptimize(walk(kNeighbour));
+          }, 1);
+          copySeconds = run == 0 ? kCopy : std::min(copySeconds, kCopy);
+          neighbourSeconds = run == 0 ? kNeighbour0 : std::min(neighbourSeconds, kNeighbour0);
+        }
+        const double kWarmNeighbour = benchmarks::measure([&]() {
+          benchmarks::doNotOptimize(walk(kNeighbour));
+        });
+        char name[96];
+        std::snprintf(name, sizeof(name), "%s copy of %zu KB", threshold ? "streaming" : "memcpy", copySize / 1024);
+        benchmarks::report(name, copySeconds, static_cast<double>(copySize));
+        std::printf("  neighbour pass over %zu KB after copy: %.3f ms (warm %.3f ms)\n",
+                    neighbourSize / 1024, neighbourSeconds * 1e3, kWarmNeighbour * 1e3);
+      }
+    }
+  }
+  CopyEngine::setStreamingThreshold(0);
+  return 0;
+}
@@ -0,0 +1,66 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <vector>
+
+#include "pub/CopyEngine.hpp"
+#include "Benchmark.hpp"
+
+using buffers::CopyEngine;
+
+/**
+ * Gathering of one field from array of structs and scattering it back:
+ * CopyEngine against loop that copies one element at a time with size known at compile time
+ */
+
+template <size_t kElemSize>
+static void copyScalar(uint8_t * _dst, const size_t _dstStride, uint8_t const * _src,
+                       const size_t _srcStride, const size_t _count) {
+  for (size_t i = 0; i < _count; ++i) {
+    std::memcpy(_dst + i * _dstStride, _src + i * _srcStride, kElemSize);
+  }
+}
+
+template <size_t kElemSize>
+static void run(const size_t _count, const size_t _stride) {
+  std::vector<uint8_t> structs(_count * _stride, 0x5A);
+  std::vector<uint8_t> field(_count * kElemSize, 0);
+  const double kBytes = static_cast<double>(_count * kElemSize);
+  const size_t kNumRuns = _count < 100000 ? 2000 : 20;
+  char name[96];
+  std::snprintf(name, sizeof(name), "gather %zu B, stride %zu, %zu elements", kElemSize, _stride, _count);
+  benchmarks::report(name, benchmarks::measure([&]() {
+    for (size_t i = 0; i < kNumRuns; ++i) {
+      CopyEngine::gather(field.data(), structs.data(), _count, _stride, kElemSize);
+      benchmarks::doNotOptimize(field.data());
+    }
+  }) / kNumRuns, kBytes);
+  std::snprintf(name, sizeof(name), "  scalar gather");
+  benchmarks::report(name, benchmarks::measure([&]() {
+    for (size_t i = 0; i < kNumRuns; ++i) {
+      copyScalar<kElemSize>(field.data(), kElemSize, structs.data(), _stride, _count);
+      benchmarks::doNotOptimize(field.data());
+    }
+  }) / kNumRuns, kBytes);
+  std::snprintf(name, sizeof(name), "  scatter");
+  benchmarks::report(name, benchmarks::measure([&]() {
+    for (size_t i = 0; i < kNumRuns; ++i) {
+      CopyEngine::scatter(structs.data(), _stride, field.data(), _count, kElemSize);
+      benchmarks::doNotOptimize(structs.data());
+    }
+  }) / kNumRuns, kBytes);
+}
+
+int main() {
+  std::printf("SIMD gather supported: %d\n", CopyEngine::isGatherSupported());
+  for (size_t count : {4096, 1024 * 1024}) {
+    for (size_t stride : {8, 12, 16, 32, 64}) {
+      run<4>(count, stride);
+    }
+    for (size_t stride : {16, 24, 32, 64}) {
+      run<8>(count, stride);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,88 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pub/CpuFeatures.hpp"
+#include "pub/Utf8.hpp"
+#include "Benchmark.hpp"
+
+using buffers::CpuFeatures;
+using buffers::Utf8;
+
+/**
+ * Throughput of UTF-8 validation of large text and of null-terminated short strings:
+ * pure ASCII, mostly Cyrillic text and mix of characters of all sizes
+ */
+
+static const size_t kTextSize = 1024 * 1024;
+
+/**
+ * Method for creating text of random characters
+ * @param _weights Relative frequency of characters of 1, 2, 3 and 4 bytes
+ */
+static std::string createText(const size_t _size, const std::vector<double> & _weights) {
+  static const char * const kChars[] = {"a", "\xD0\xBF", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+  std::mt19937 random(42);
+  std::discrete_distribution<size_t> charSize(_weights.begin(), _weights.end());
+  std::string text;
+  while (text.size() < _size) {
+    const size_t kSize = charSize(random);
+    text += kSize == 0 ? static_cast<char>('a' + random() % 26) : kChars[kSize][0];
+    text.append(kChars[kSize] + 1);
+  }
+  return text;
+}
+
+static void runValidate(const char * _name, const std::string & _text) {
+  const uint8_t * pText = reinterpret_cast<const uint8_t *>(_text.data());
+  const size_t kNumRuns = 20;
+  benchmarks::report(_name, benchmarks::measure([&]() {
+    for (size_t i = 0; i < kNumRuns; ++i) {
+      benchmarks::doNotOptimize(Utf8::validate(pText, _text.size()));
+    }
+  }) / kNumRuns, static_cast<double>(_text.size()));
+}
+
+static void runScanStrings(const char * _name, const std::string & _text, const size_t _length) {
+  std::vector<uint8_t> strings;
+  size_t start = 0;
+  while (start + _length <= _text.size()) {
+    size_t end = start + _length;
+    while (end < _text.size() && (static_cast<uint8_t>(_text[end]) & 0xC0) == 0x80) {
+      ++end;
+    }
+    strings.insert(strings.end(), _text.begin() + start, _text.begin() + end);
+    strings.push_back(0);
+    start = end;
+  }
+  const size_t kNumRuns = 20;
+  benchmarks::report(_name, benchmarks::measure([&]() {
+    for (size_t i = 0; i < kNumRuns; ++i) {
+      size_t offset = 0;
+      while (offset < strings.size()) {
+        size_t length = 0;
+        benchmarks::doNotOptimize(Utf8::scanString(strings.data() + offset, strings.size() - offset, length));
+        offset += length + 1;
+      }
+    }
+  }) / kNumRuns, static_cast<double>(strings.size()));
+}
+
+int main() {
+  std::printf("SSE2 supported: %d, AVX2 supported: %d\n", CpuFeatures::hasSse2(), CpuFeatures::hasAvx2());
+  const std::string kAscii = createText(kTextSize, {1, 0, 0, 0});
+  const std::string kCyrillic = createText(kTextSize, {0.2, 0.8, 0, 0});
+  const std::string kMixed = createText(kTextSize, {0.6, 0.25, 0.1, 0.05});
+  runValidate("validate ASCII text", kAscii);
+  runValidate("validate Cyrillic text", kCyrillic);
+  runValidate("validate mixed text", kMixed);
+  runScanStrings("scan ASCII strings of 24 B", kAscii, 24);
+  runScanStrings("scan mixed strings of 24 B", kMixed, 24);
+  runScanStrings("scan ASCII strings of 256 B", kAscii, 256);
+  runScanStrings("scan mixed strings of 256 B", kMixed, 256);
+  return 0;
+}
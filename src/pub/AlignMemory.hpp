@@ -9,15 +9,58 @@
 #ifndef BUFFERS_ALIGNMEMORY_HPP
 #define BUFFERS_ALIGNMEMORY_HPP
 
+#include <stddef.h>
+
 namespace buffers {
 
+/**
+ * Alignment of values in buffer.
+ * Bits_* modes round size of every value up to the same memory chunk.
+ * Natural mode places every value at its own alignof(T) boundary relative
+ * to the beginning of buffer and does not round up size of values
+ */
 enum class AlignMemory {
+  Natural = 0,
   Bits_8 = 1,
   Bits_16 = 2,
   Bits_32 = 4,
   Bits_64 = 8,
 };
 
+/**
+ * Method for getting size of data rounded up to the memory chunk of alignment
+ * @param _size Size of data
+ * @param _alignment Alignment of memory
+ * @return Aligned size of data
+ */
+constexpr size_t getAlignedSize(const size_t _size, const AlignMemory _alignment) {
+  return _alignment == AlignMemory::Natural
+         ? _size
+         : ((_size + static_cast<size_t>(_alignment) - 1) / static_cast<size_t>(_alignment)) *
+           static_cast<size_t>(_alignment);
+}
+
+/**
+ * Method for getting offset at which value should be placed in buffer.
+ * Offset is changed only for natural alignment
+ * @param _offset Offset of the next free byte from the beginning of buffer
+ * @param _typeAlignment Alignment of type of value, alignof(T)
+ * @param _alignment Alignment of memory
+ * @return Offset of value from the beginning of buffer
+ */
+constexpr size_t getAlignedOffset(const size_t _offset, const size_t _typeAlignment, const AlignMemory _alignment) {
+  return _alignment == AlignMemory::Natural
+         ? ((_offset + _typeAlignment - 1) / _typeAlignment) * _typeAlignment
+         : _offset;
+}
+
+/**
+ * Flag in packed number of elements of array which payload is placed at array boundary.
+ * Such number is followed by recorded size of padding, so arrays are unpacked
+ * without knowing options with which they were packed
+ */
+constexpr size_t kArrayPaddingFlag = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+
 }
 
 #endif //BUFFERS_ALIGNMEMORY_HPP
@@ -0,0 +1,122 @@
+/**
+ * @file ArrayView.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains zero-copy view over packed arrays of trivial type
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_ARRAYVIEW_HPP
+#define BUFFERS_ARRAYVIEW_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * View over std::vector or raw array of trivial type packed with PackBuffer.
+   * Elements are not copied, view points directly into the packed buffer.
+   * If array is packed at array boundary (see PackBuffer::setArrayAlignment)
+   * and buffer is allocated at the same boundary, data() could be used
+   * for aligned SIMD loads
+   * @tparam T Type of elements. Should be a trivial type
+   */
+  template <typename T>
+  class ArrayView {
+#if __cplusplus > 199711L
+    static_assert(std::is_trivial<T>::value, "Type of elements is not a trivial type !!");
+#endif
+
+   public:
+    ArrayView()
+        : p_data_{nullptr}
+        , size_{0} {
+    }
+
+    ArrayView(uint8_t const * _pData, const size_t _size)
+        : p_data_{_pData}
+        , size_{_size} {
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    /**
+     * Method for getting pointer to the first element.
+     * Pointer could be dereferenced only if isAligned(alignof(T)) is true
+     * @return Pointer to the first element
+     */
+    T const * data() const {
+      return reinterpret_cast<T const *>(p_data_);
+    }
+
+    /**
+     * Method for reading element, safe for any alignment of array
+     * @param _idx Index of element
+     * @return Copy of element
+     */
+    T operator[](const size_t _idx) const {
+      T result;
+      std::memcpy(&result, p_data_ + _idx * sizeof(T), sizeof(T));
+      return result;
+    }
+
+    /**
+     * Method for checking if address of the first element is multiple of boundary
+     * @param _boundary Boundary, power of two
+     * @return true if array is aligned, false otherwise
+     */
+    bool isAligned(const size_t _boundary) const {
+      return (reinterpret_cast<uintptr_t>(p_data_) & (_boundary - 1)) == 0;
+    }
+
+    /**
+     * Method for copying of elements into standard vector
+     * @return Vector with elements of array
+     */
+    std::vector<T> toVector() const {
+      std::vector<T> result(size_);
+      if (size_ > 0) {
+        std::memcpy(result.data(), p_data_, size_ * sizeof(T));
+      }
+      return result;
+    }
+
+   private:
+    uint8_t const * p_data_;
+    size_t size_;
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for ArrayView.
+   * Does not copy elements, only moves context after the packed array
+   */
+  template<typename T>
+  class UnpackBuffer::DelegateUnpackBuffer<ArrayView<T>> {
+   public:
+    template <typename TBufferContext>
+    static ArrayView<T> get(TBufferContext & _ctx) {
+      const auto kSize = getArrayCount(_ctx);
+      _ctx.align(alignof(T));
+      ArrayView<T> result(_ctx.buffer(), kSize);
+      _ctx += kSize * sizeof(T);
+      return result;
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      get(_ctx);
+    }
+  };
+}
+
+#endif //BUFFERS_ARRAYVIEW_HPP
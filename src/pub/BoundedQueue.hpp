@@ -0,0 +1,186 @@
+/**
+ * @file BoundedQueue.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains lock-free bounded multi-producer multi-consumer queue
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_BOUNDEDQUEUE_HPP
+#define BUFFERS_BOUNDEDQUEUE_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+#include "Waiter.hpp"
+
+namespace buffers {
+  /**
+   * Lock-free bounded multi-producer multi-consumer queue (D. Vyukov).
+   * Every cell holds sequence number, which tells producers and consumers
+   * whether cell is free or filled for their position, so one CAS on position
+   * is enough for push and pop. Values are popped in the order of push.
+   * push() and pop() spin for a while on full and empty queue and then block,
+   * so idle consumers and back-pressured producers do not burn CPU
+   * @tparam T Type of values. Should be default constructible and copy assignable
+   */
+  template <typename T>
+  class BoundedQueue {
+   public:
+    /**
+     * Constructor of queue
+     * @param _capacity Minimum capacity of queue, rounded up to power of two
+     */
+    explicit BoundedQueue(const size_t _capacity)
+        : mask_{getCapacity(_capacity) - 1}
+        , cells_{new Cell[mask_ + 1]}
+        , enqueue_pos_{0}
+        , dequeue_pos_{0}
+        , closed_{false} {
+      for (size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * Method for pushing value without waiting
+     * @param _value Value for pushing
+     * @return Return true if value is pushed, false if queue is full
+     */
+    bool tryPush(const T & _value) {
+      Cell * cell;
+      size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+      for (;;) {
+        cell = &cells_[pos & mask_];
+        const size_t kSequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t kDiff = static_cast<intptr_t>(kSequence) - static_cast<intptr_t>(pos);
+        if (kDiff == 0) {
+          if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (kDiff < 0) {
+          return false;
+        } else {
+          pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+      }
+      cell->data = _value;
+      cell->sequence.store(pos + 1, std::memory_order_release);
+      not_empty_.notifyOne();
+      return true;
+    }
+
+    /**
+     * Method for popping value without waiting
+     * @param _value Popped value
+     * @return Return true if value is popped, false if queue is empty
+     */
+    bool tryPop(T & _value) {
+      Cell * cell;
+      size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+      for (;;) {
+        cell = &cells_[pos & mask_];
+        const size_t kSequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t kDiff = static_cast<intptr_t>(kSequence) - static_cast<intptr_t>(pos + 1);
+        if (kDiff == 0) {
+          if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (kDiff < 0) {
+          return false;
+        } else {
+          pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+      }
+      _value = cell->data;
+      cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+      not_full_.notifyOne();
+      return true;
+    }
+
+    /**
+     * Method for pushing value, waits while queue is full
+     * @param _value Value for pushing
+     */
+    void push(const T & _value) {
+      not_full_.wait([this, &_value]() {
+        return tryPush(_value);
+      });
+    }
+
+    /**
+     * Method for popping value, waits while queue is empty and not closed
+     * @param _value Popped value
+     * @return Return true if value is popped, false if queue is closed and empty
+     */
+    bool pop(T & _value) {
+      bool popped = false;
+      not_empty_.wait([this, &_value, &popped]() {
+        popped = tryPop(_value);
+        return popped || closed_.load(std::memory_order_acquire);
+      });
+      return popped;
+    }
+
+    /**
+     * Method for closing queue after the last push.
+     * Consumers waiting in pop() pop the rest of values and then return false
+     */
+    void close() {
+      closed_.store(true, std::memory_order_release);
+      not_empty_.notifyAll();
+    }
+
+    /**
+     * Method for opening closed queue for the next pushes
+     */
+    void open() {
+      closed_.store(false, std::memory_order_release);
+    }
+
+    /**
+     * Method for getting capacity of queue
+     * @return Capacity of queue
+     */
+    size_t capacity() const {
+      return mask_ + 1;
+    }
+
+   private:
+    struct Cell {
+      std::atomic<size_t> sequence;
+      T data;
+    };
+
+    static size_t getCapacity(const size_t _capacity) {
+      size_t capacity = 2;
+      while (capacity < _capacity) {
+        capacity <<= 1;
+      }
+      return capacity;
+    }
+
+    static constexpr size_t kCacheLineSize = 64;
+
+    const size_t mask_;
+    const std::unique_ptr<Cell[]> cells_;
+    /**
+     * Positions are separated by padding, so producers and consumers
+     * do not invalidate cache line of each other
+     */
+    uint8_t padding0_[kCacheLineSize];
+    std::atomic<size_t> enqueue_pos_;
+    uint8_t padding1_[kCacheLineSize];
+    std::atomic<size_t> dequeue_pos_;
+    uint8_t padding2_[kCacheLineSize];
+    std::atomic<bool> closed_;
+    Waiter not_empty_;
+    Waiter not_full_;
+  };
+}
+
+#endif //BUFFERS_BOUNDEDQUEUE_HPP
@@ -0,0 +1,162 @@
+/**
+ * @file BufferPool.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains pool of reusable Heap based Pack Buffers
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_BUFFERPOOL_HPP
+#define BUFFERS_BUFFERPOOL_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AlignMemory.hpp"
+#include "HeapPackBuffer.hpp"
+#include "NumaTopology.hpp"
+
+namespace buffers {
+  /**
+   * Pool of Heap based Pack Buffers of the same size.
+   * Released buffers are reset and reused instead of allocating new ones.
+   * Pool is sharded per NUMA node: buffer is acquired from free list of node
+   * of the current thread and is allocated by this thread if the list is empty,
+   * so its memory is placed on this node by first touch of zero filling.
+   * Released buffer always returns to its own node, release from another node
+   * is counted as cross-node handoff. On single node machine pool has one shard.
+   * Pool owns all buffers, they are deleted together with pool.
+   * Topology passed to pool should outlive it
+   */
+  class BufferPool {
+   public:
+    /**
+     * Constructor of pool
+     * @param _bufferSize Size of every buffer in pool
+     * @param _alignment Alignment of buffers in pool
+     * @param _numaAware true to shard pool per NUMA node, false to use one shard
+     * @param _topology NUMA topology of machine
+     */
+    explicit BufferPool(const size_t _bufferSize,
+                        AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)),
+                        const bool _numaAware = true,
+                        const NumaTopology & _topology = NumaTopology::get())
+        : buffer_size_{_bufferSize}
+        , alignment_{_alignment}
+        , topology_(_topology)
+        , numa_aware_{_numaAware && _topology.getNumNodes() > 1}
+        , shards_(numa_aware_ ? _topology.getNumNodes() : 1)
+        , num_cross_node_{0} {
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * Method for acquiring empty buffer from pool
+     * @return Pointer to the buffer owned by pool
+     */
+    HeapPackBuffer * acquire() {
+      const size_t kNode = getCurrentShard();
+      Shard & shard = shards_[kNode];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.free_buffers.empty()) {
+        shard.buffers.emplace_back(new PooledBuffer(buffer_size_, alignment_, kNode));
+        return shard.buffers.back().get();
+      }
+      HeapPackBuffer * buffer = shard.free_buffers.back();
+      shard.free_buffers.pop_back();
+      return buffer;
+    }
+
+    /**
+     * Method for returning buffer to pool
+     * @param _buffer Buffer previously acquired from this pool
+     */
+    void release(HeapPackBuffer * _buffer) {
+      _buffer->reset();
+      const size_t kNode = static_cast<PooledBuffer *>(_buffer)->node;
+      if (numa_aware_ && kNode != getCurrentShard()) {
+        num_cross_node_.fetch_add(1, std::memory_order_relaxed);
+      }
+      Shard & shard = shards_[kNode];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.free_buffers.push_back(_buffer);
+    }
+
+    /**
+     * Method for getting size of every buffer in pool
+     * @return Size of buffer
+     */
+    size_t getBufferSize() const {
+      return buffer_size_;
+    }
+
+    /**
+     * Method for getting number of buffers allocated by pool
+     * @return Number of allocated buffers
+     */
+    size_t getNumBuffers() const {
+      size_t numBuffers = 0;
+      for (const auto & shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        numBuffers += shard.buffers.size();
+      }
+      return numBuffers;
+    }
+
+    /**
+     * Method for getting number of shards, one per NUMA node
+     * @return Number of shards
+     */
+    size_t getNumShards() const {
+      return shards_.size();
+    }
+
+    /**
+     * Method for getting number of buffers released on another NUMA node
+     * than node where they were allocated
+     * @return Number of cross-node handoffs
+     */
+    size_t getNumCrossNodeReleases() const {
+      return num_cross_node_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    /**
+     * Buffer that remembers shard where it was allocated
+     */
+    class PooledBuffer
+        : public HeapPackBuffer {
+     public:
+      PooledBuffer(const size_t _size, AlignMemory _alignment, const size_t _node)
+          : HeapPackBuffer(_size, _alignment)
+          , node{_node} {
+      }
+
+      const size_t node;
+    };
+
+    struct Shard {
+      mutable std::mutex mutex;
+      std::vector<std::unique_ptr<PooledBuffer>> buffers;
+      std::vector<HeapPackBuffer *> free_buffers;
+    };
+
+    size_t getCurrentShard() const {
+      return numa_aware_ ? topology_.getCurrentNode() % shards_.size() : 0;
+    }
+
+    const size_t buffer_size_;
+    const AlignMemory alignment_;
+    const NumaTopology & topology_;
+    const bool numa_aware_;
+    std::vector<Shard> shards_;
+    std::atomic<size_t> num_cross_node_;
+  };
+}
+
+#endif //BUFFERS_BUFFERPOOL_HPP
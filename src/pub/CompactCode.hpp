@@ -0,0 +1,36 @@
+/**
+ * @file CompactCode.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains switches of code size conscious mode of buffers
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_COMPACTCODE_HPP
+#define BUFFERS_COMPACTCODE_HPP
+
+/**
+ * If PUB_COMPACT_CODE is defined for the whole program, per-element loops of node based containers
+ * and loops over strings are not instantiated for every packed type. They go through shared
+ * out-of-line routines and only small callable that handles one element is instantiated per type.
+ * Trivial types and std::vector of trivial types keep their inlined fast paths.
+ * Wire format does not depend on the mode, but the mode should be the same in all translation units
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define BUFFERS_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BUFFERS_NOINLINE __declspec(noinline)
+#else
+#define BUFFERS_NOINLINE
+#endif
+
+/**
+ * Marks routine that is inlined normally, but is kept out-of-line in PUB_COMPACT_CODE mode
+ */
+#ifdef PUB_COMPACT_CODE
+#define BUFFERS_COMPACT_NOINLINE BUFFERS_NOINLINE
+#else
+#define BUFFERS_COMPACT_NOINLINE
+#endif
+
+#endif //BUFFERS_COMPACTCODE_HPP
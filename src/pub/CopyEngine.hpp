@@ -0,0 +1,245 @@
+/**
+ * @file CopyEngine.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains copy engine used by buffers for bulk copies of data
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_COPYENGINE_HPP
+#define BUFFERS_COPYENGINE_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <atomic>
+
+#include "CpuFeatures.hpp"
+
+#ifdef BUFFERS_X86_SIMD
+#include <immintrin.h>
+#define BUFFERS_STREAMING_COPY 1
+#define BUFFERS_SIMD_GATHER 1
+#endif
+
+namespace buffers {
+  /**
+   * Copy engine for bulk copies of packed data.
+   * Copies larger than streaming threshold are done with non-temporal stores,
+   * so large snapshots do not evict from cache data of other threads.
+   * Streaming copy is disabled by default and used only if CPU supports it.
+   * Strided copies of 4 and 8 byte elements are gathered with AVX2 if CPU supports it
+   */
+  class CopyEngine {
+   public:
+    /**
+     * Method for copying of data
+     * @param _dst Destination of data
+     * @param _src Source of data
+     * @param _size Size of data
+     */
+    static void copy(uint8_t * _dst, uint8_t const * _src, const size_t _size) {
+      const size_t kThreshold = getStreamingThreshold();
+      if (kThreshold != 0 && _size >= kThreshold && isStreamingSupported()) {
+        streamingCopy(_dst, _src, _size);
+      } else {
+        std::memcpy(_dst, _src, _size);
+      }
+    }
+
+    /**
+     * Method for copying of elements placed at equal distance to continuous memory,
+     * for example one field from array of structs
+     * @param _dst Destination of elements
+     * @param _src Source of the first element
+     * @param _count Number of elements
+     * @param _stride Distance between source elements in bytes
+     * @param _elemSize Size of element in bytes
+     */
+    static void gather(uint8_t * _dst, uint8_t const * _src, const size_t _count,
+                       const size_t _stride, const size_t _elemSize) {
+      if (_stride == _elemSize) {
+        copy(_dst, _src, _count * _elemSize);
+        return;
+      }
+      size_t i = 0;
+#ifdef BUFFERS_SIMD_GATHER
+      if (isGatherSupported() && _stride <= kMaxGatherStride) {
+        if (_elemSize == sizeof(uint32_t)) {
+          i = gather32(_dst, _src, _count, _stride);
+        } else if (_elemSize == sizeof(uint64_t)) {
+          i = gather64(_dst, _src, _count, _stride);
+        }
+      }
+#endif
+      copyStrided(_dst + i * _elemSize, _elemSize, _src + i * _stride, _stride, _count - i, _elemSize);
+    }
+
+    /**
+     * Method for copying of continuous elements to memory at equal distance,
+     * for example to one field of array of structs
+     * @param _dst Destination of the first element
+     * @param _stride Distance between destination elements in bytes
+     * @param _src Source of elements
+     * @param _count Number of elements
+     * @param _elemSize Size of element in bytes
+     */
+    static void scatter(uint8_t * _dst, const size_t _stride, uint8_t const * _src,
+                        const size_t _count, const size_t _elemSize) {
+      if (_stride == _elemSize) {
+        copy(_dst, _src, _count * _elemSize);
+        return;
+      }
+      copyStrided(_dst, _stride, _src, _elemSize, _count, _elemSize);
+    }
+
+    /**
+     * Method for checking if CPU supports SIMD gather
+     * @return true if SIMD gather is supported, false otherwise
+     */
+    static bool isGatherSupported() {
+#ifdef BUFFERS_SIMD_GATHER
+      return CpuFeatures::hasAvx2();
+#else
+      return false;
+#endif
+    }
+
+    /**
+     * Method for setting size of copy after which non-temporal stores are used
+     * @param _threshold Size of copy in bytes, 0 disables streaming copy
+     */
+    static void setStreamingThreshold(const size_t _threshold) {
+      threshold().store(_threshold, std::memory_order_relaxed);
+    }
+
+    /**
+     * Method for getting size of copy after which non-temporal stores are used
+     * @return Size of copy in bytes, 0 if streaming copy is disabled
+     */
+    static size_t getStreamingThreshold() {
+      return threshold().load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Method for checking if CPU supports streaming copy
+     * @return true if streaming copy is supported, false otherwise
+     */
+    static bool isStreamingSupported() {
+#ifdef BUFFERS_STREAMING_COPY
+      return CpuFeatures::hasSse2();
+#else
+      return false;
+#endif
+    }
+
+   private:
+    /**
+     * Maximum stride for which offsets of 8 gathered elements fit in 32 bit indices
+     */
+    static constexpr size_t kMaxGatherStride = 0x7FFFFFFF / 8;
+
+    /**
+     * Method for strided copy of elements.
+     * Common sizes are dispatched to copies with size known at compile time,
+     * so every element is copied by one load and one store
+     */
+    static void copyStrided(uint8_t * _dst, const size_t _dstStride, uint8_t const * _src,
+                            const size_t _srcStride, const size_t _count, const size_t _elemSize) {
+      switch (_elemSize) {
+        case 1: copyStrided<1>(_dst, _dstStride, _src, _srcStride, _count); break;
+        case 2: copyStrided<2>(_dst, _dstStride, _src, _srcStride, _count); break;
+        case 4: copyStrided<4>(_dst, _dstStride, _src, _srcStride, _count); break;
+        case 8: copyStrided<8>(_dst, _dstStride, _src, _srcStride, _count); break;
+        default:
+          for (size_t i = 0; i < _count; ++i) {
+            std::memcpy(_dst + i * _dstStride, _src + i * _srcStride, _elemSize);
+          }
+          break;
+      }
+    }
+
+    template <size_t kElemSize>
+    static void copyStrided(uint8_t * _dst, const size_t _dstStride, uint8_t const * _src,
+                            const size_t _srcStride, const size_t _count) {
+      for (size_t i = 0; i < _count; ++i) {
+        std::memcpy(_dst + i * _dstStride, _src + i * _srcStride, kElemSize);
+      }
+    }
+
+#ifdef BUFFERS_SIMD_GATHER
+    /**
+     * Method for gathering 4 byte elements, 8 elements at a time
+     * @return Number of gathered elements
+     */
+    __attribute__((target("avx2")))
+    static size_t gather32(uint8_t * _dst, uint8_t const * _src, const size_t _count, const size_t _stride) {
+      const int kStride = static_cast<int>(_stride);
+      const __m256i kOffsets = _mm256_setr_epi32(0, kStride, 2 * kStride, 3 * kStride,
+                                                 4 * kStride, 5 * kStride, 6 * kStride, 7 * kStride);
+      size_t i = 0;
+      for (; i + 8 <= _count; i += 8) {
+        const __m256i kChunk = _mm256_i32gather_epi32(reinterpret_cast<const int *>(_src + i * _stride), kOffsets, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(_dst + i * sizeof(uint32_t)), kChunk);
+      }
+      return i;
+    }
+
+    /**
+     * Method for gathering 8 byte elements, 4 elements at a time
+     * @return Number of gathered elements
+     */
+    __attribute__((target("avx2")))
+    static size_t gather64(uint8_t * _dst, uint8_t const * _src, const size_t _count, const size_t _stride) {
+      const int kStride = static_cast<int>(_stride);
+      const __m128i kOffsets = _mm_setr_epi32(0, kStride, 2 * kStride, 3 * kStride);
+      size_t i = 0;
+      for (; i + 4 <= _count; i += 4) {
+        const __m256i kChunk = _mm256_i32gather_epi64(reinterpret_cast<const long long *>(_src + i * _stride), kOffsets, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(_dst + i * sizeof(uint64_t)), kChunk);
+      }
+      return i;
+    }
+#endif
+
+    static std::atomic<size_t> & threshold() {
+      static std::atomic<size_t> value{0};
+      return value;
+    }
+
+#ifdef BUFFERS_STREAMING_COPY
+    __attribute__((target("sse2")))
+    static void streamingCopy(uint8_t * _dst, uint8_t const * _src, size_t _size) {
+      const size_t kHeadSize = (16 - (reinterpret_cast<uintptr_t>(_dst) & 15)) & 15;
+      if (kHeadSize >= _size) {
+        std::memcpy(_dst, _src, _size);
+        return;
+      }
+      std::memcpy(_dst, _src, kHeadSize);
+      _dst += kHeadSize;
+      _src += kHeadSize;
+      _size -= kHeadSize;
+      while (_size >= 64) {
+        const __m128i kChunk0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src));
+        const __m128i kChunk1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + 16));
+        const __m128i kChunk2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + 32));
+        const __m128i kChunk3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i *>(_dst), kChunk0);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(_dst + 16), kChunk1);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(_dst + 32), kChunk2);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(_dst + 48), kChunk3);
+        _dst += 64;
+        _src += 64;
+        _size -= 64;
+      }
+      _mm_sfence();
+      std::memcpy(_dst, _src, _size);
+    }
+#else
+    static void streamingCopy(uint8_t * _dst, uint8_t const * _src, size_t _size) {
+      std::memcpy(_dst, _src, _size);
+    }
+#endif
+  };
+}
+
+#endif //BUFFERS_COPYENGINE_HPP
@@ -0,0 +1,55 @@
+/**
+ * @file CpuFeatures.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains runtime detection of SIMD extensions used by buffers
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_CPUFEATURES_HPP
+#define BUFFERS_CPUFEATURES_HPP
+
+/**
+ * Defined if x86 SIMD routines could be compiled with target attributes,
+ * so they are built together with baseline code and selected at runtime
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BUFFERS_X86_SIMD 1
+#endif
+
+namespace buffers {
+  /**
+   * Detection of SIMD extensions supported by CPU.
+   * Every extension is detected once per process
+   */
+  class CpuFeatures {
+   public:
+    /**
+     * Method for checking if CPU supports SSE2
+     * @return true if SSE2 is supported, false otherwise
+     */
+    static bool hasSse2() {
+#ifdef BUFFERS_X86_SIMD
+      static const bool kIsSupported = __builtin_cpu_supports("sse2");
+      return kIsSupported;
+#else
+      return false;
+#endif
+    }
+
+    /**
+     * Method for checking if CPU supports AVX2
+     * @return true if AVX2 is supported, false otherwise
+     */
+    static bool hasAvx2() {
+#ifdef BUFFERS_X86_SIMD
+      static const bool kIsSupported = __builtin_cpu_supports("avx2");
+      return kIsSupported;
+#else
+      return false;
+#endif
+    }
+  };
+}
+
+#endif //BUFFERS_CPUFEATURES_HPP
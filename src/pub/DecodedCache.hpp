@@ -0,0 +1,166 @@
+/**
+ * @file DecodedCache.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains cache of decoded objects keyed by hash of packed message
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_DECODEDCACHE_HPP
+#define BUFFERS_DECODEDCACHE_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include "AlignMemory.hpp"
+#include "Hash.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Bounded cache of immutable decoded objects keyed by hash of packed message.
+   * Repeated message is hashed and looked up instead of decoding it again.
+   * Bytes of cached message are kept and compared on hit, so hash collision
+   * never returns object of another message. Least recently used object is
+   * evicted when cache is full. Cache is thread safe, decoding is done
+   * outside of the lock
+   * @tparam T Type of decoded object
+   */
+  template <typename T>
+  class DecodedCache {
+   public:
+    /**
+     * Constructor of cache
+     * @param _capacity Maximum number of cached objects
+     */
+    explicit DecodedCache(const size_t _capacity)
+        : capacity_{_capacity > 0 ? _capacity : 1}
+        , num_hits_{0}
+        , num_misses_{0} {
+    }
+
+    DecodedCache(const DecodedCache&) = delete;
+    DecodedCache& operator=(const DecodedCache&) = delete;
+
+    /**
+     * Method for getting decoded object of packed message.
+     * Message is decoded by UnpackBuffer::get<T>() only if it is not cached
+     * @param _pMsg Pointer to the packed message
+     * @param _size Size of packed message
+     * @param _alignment Alignment with which message was packed
+     * @return Shared immutable decoded object
+     */
+    std::shared_ptr<const T> get(uint8_t const * _pMsg, const size_t _size,
+                                 AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int))) {
+      const uint64_t kHash = Hash64::hash(_pMsg, _size, static_cast<uint64_t>(_alignment));
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto entryIter = entries_.find(kHash);
+        if (entryIter != entries_.end() && isSameMessage(*entryIter->second, _pMsg, _size, _alignment)) {
+          lru_.splice(lru_.begin(), lru_, entryIter->second);
+          ++num_hits_;
+          return entryIter->second->object;
+        }
+        ++num_misses_;
+      }
+      UnpackBuffer unbuffer(_pMsg, _size, _alignment);
+      std::shared_ptr<const T> object = std::make_shared<const T>(unbuffer.template get<T>());
+      insert(kHash, _pMsg, _size, _alignment, object);
+      return object;
+    }
+
+    /**
+     * Method for removing all cached objects.
+     * Objects still used by callers stay alive until they are released
+     */
+    void clear() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries_.clear();
+      lru_.clear();
+    }
+
+    /**
+     * Method for getting maximum number of cached objects
+     * @return Capacity of cache
+     */
+    size_t getCapacity() const {
+      return capacity_;
+    }
+
+    /**
+     * Method for getting number of cached objects
+     * @return Number of cached objects
+     */
+    size_t getSize() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return lru_.size();
+    }
+
+    /**
+     * Method for getting number of messages found in cache
+     * @return Number of hits
+     */
+    size_t getNumHits() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return num_hits_;
+    }
+
+    /**
+     * Method for getting number of messages that were decoded
+     * @return Number of misses
+     */
+    size_t getNumMisses() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return num_misses_;
+    }
+
+   private:
+    struct Entry {
+      uint64_t hash;
+      AlignMemory alignment;
+      std::vector<uint8_t> message;
+      std::shared_ptr<const T> object;
+    };
+
+    static bool isSameMessage(const Entry & _entry, uint8_t const * _pMsg, const size_t _size,
+                              AlignMemory _alignment) {
+      return _entry.alignment == _alignment &&
+             _entry.message.size() == _size &&
+             (_size == 0 || std::memcmp(_entry.message.data(), _pMsg, _size) == 0);
+    }
+
+    /**
+     * Method for inserting decoded object as most recently used.
+     * Entry with the same hash is replaced, because either the same message
+     * was decoded concurrently or it is a collision
+     */
+    void insert(const uint64_t _hash, uint8_t const * _pMsg, const size_t _size,
+                AlignMemory _alignment, const std::shared_ptr<const T> & _object) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entryIter = entries_.find(_hash);
+      if (entryIter != entries_.end()) {
+        lru_.erase(entryIter->second);
+        entries_.erase(entryIter);
+      } else if (lru_.size() == capacity_) {
+        entries_.erase(lru_.back().hash);
+        lru_.pop_back();
+      }
+      lru_.push_front(Entry{_hash, _alignment, std::vector<uint8_t>(_pMsg, _pMsg + _size), _object});
+      entries_.emplace(_hash, lru_.begin());
+    }
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;
+    std::unordered_map<uint64_t, typename std::list<Entry>::iterator> entries_;
+    size_t num_hits_;
+    size_t num_misses_;
+  };
+}
+
+#endif //BUFFERS_DECODEDCACHE_HPP
@@ -0,0 +1,250 @@
+/**
+ * @file FrameForwarder.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains zero-copy forwarding of framed messages from file to socket or pipe
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_FRAMEFORWARDER_HPP
+#define BUFFERS_FRAMEFORWARDER_HPP
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/sendfile.h>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "AlignMemory.hpp"
+
+namespace buffers {
+  /**
+   * Forwarder of framed messages from file to socket or pipe.
+   * Frames are length of message followed by the packed message, as they are
+   * written by PackBuffer::put(message.getData(), message.getDataSize()).
+   * Only frame headers are read into user space, payload is moved by sendfile
+   * inside of kernel. Only complete frames are forwarded
+   */
+  class FrameForwarder {
+   public:
+    /**
+     * Maximum number of frames moved by one call of sendfile
+     */
+    static constexpr size_t kMaxFramesInBatch = 1024;
+
+    /**
+     * Size of window of file from which frame headers are read,
+     * so headers of small frames are read by one pread
+     */
+    static constexpr size_t kHeaderWindowSize = 64 * 1024;
+
+    /**
+     * Constructor of forwarder
+     * @param _inFd File descriptor of file with frames
+     * @param _outFd File descriptor of socket or pipe
+     * @param _offset Offset of the first frame in file
+     * @param _alignment Alignment with which frames are packed
+     */
+    FrameForwarder(const int _inFd, const int _outFd, const off_t _offset = 0,
+                   AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+        : in_fd_{_inFd}
+        , out_fd_{_outFd}
+        , offset_{_offset}
+        , sent_{_offset}
+        , partial_end_{_offset}
+        , alignment_{_alignment}
+        , num_frames_{0}
+        , header_window_(kHeaderWindowSize)
+        , window_start_{0}
+        , window_end_{0} {
+    }
+
+    /**
+     * Method for forwarding frames.
+     * Frames are counted as forwarded only when they are sent completely. If sending fails
+     * in the middle of frame, bytes of the frame already sent are reported by getPartialBytes()
+     * and the next call sends the rest of this frame first, so output stays a valid stream of frames
+     * @param _maxFrames Maximum number of frames to forward
+     * @return Number of forwarded frames, could be less than _maxFrames
+     *         in case of end of file, incomplete frame or error
+     */
+    size_t forward(const size_t _maxFrames = std::numeric_limits<size_t>::max()) {
+      struct stat fileStat;
+      if (_maxFrames == 0 || fstat(in_fd_, &fileStat) != 0) {
+        return 0;
+      }
+      size_t numForwarded = 0;
+      if (sent_ > offset_) {
+        if (!transfer(static_cast<size_t>(partial_end_ - sent_))) {
+          return 0;
+        }
+        offset_ = sent_;
+        ++numForwarded;
+      }
+      window_end_ = window_start_;
+      const off_t kFileSize = fileStat.st_size;
+      const off_t kHeaderSize = static_cast<off_t>(getAlignedSize(sizeof(size_t), alignment_));
+      off_t frameEnds[kMaxFramesInBatch];
+      while (numForwarded < _maxFrames) {
+        off_t batchEnd = offset_;
+        size_t numInBatch = 0;
+        while (numInBatch < kMaxFramesInBatch && numForwarded + numInBatch < _maxFrames &&
+               kFileSize - batchEnd >= kHeaderSize) {
+          size_t msgSize;
+          if (!readHeader(batchEnd, msgSize)) {
+            break;
+          }
+          const off_t kFrameSize = kHeaderSize + static_cast<off_t>(getAlignedSize(msgSize, alignment_));
+          if (msgSize > static_cast<size_t>(kFileSize - batchEnd) || kFileSize - batchEnd < kFrameSize) {
+            break;
+          }
+          const off_t kFrameEnd = static_cast<off_t>(getAlignedOffset(static_cast<size_t>(batchEnd + kFrameSize),
+                                                                      alignof(size_t), alignment_));
+          batchEnd = std::min(kFrameEnd, kFileSize);
+          frameEnds[numInBatch++] = batchEnd;
+        }
+        if (numInBatch == 0) {
+          break;
+        }
+        const bool kIsSent = transfer(static_cast<size_t>(batchEnd - offset_));
+        const size_t kNumSent = static_cast<size_t>(
+            std::upper_bound(frameEnds, frameEnds + numInBatch, sent_) - frameEnds);
+        numForwarded += kNumSent;
+        offset_ = kNumSent > 0 ? frameEnds[kNumSent - 1] : offset_;
+        if (!kIsSent) {
+          if (sent_ > offset_) {
+            partial_end_ = frameEnds[kNumSent];
+          }
+          break;
+        }
+      }
+      num_frames_ += numForwarded;
+      return numForwarded;
+    }
+
+    /**
+     * Method for getting offset of the next frame in file
+     * @return Offset of the next frame
+     */
+    off_t getOffset() const {
+      return offset_;
+    }
+
+    /**
+     * Method for getting number of bytes of the next frame sent before error
+     * @return Number of bytes already sent, 0 if the last frame was sent completely
+     */
+    size_t getPartialBytes() const {
+      return static_cast<size_t>(sent_ - offset_);
+    }
+
+    /**
+     * Method for getting number of frames forwarded since creation of forwarder
+     * @return Number of forwarded frames
+     */
+    size_t getForwardedFrames() const {
+      return num_frames_;
+    }
+
+   private:
+    bool readHeader(const off_t _offset, size_t & _msgSize) {
+      if (_offset < window_start_ || _offset + static_cast<off_t>(sizeof(_msgSize)) > window_end_) {
+        const ssize_t kRead = pread(in_fd_, header_window_.data(), header_window_.size(), _offset);
+        if (kRead < static_cast<ssize_t>(sizeof(_msgSize))) {
+          window_end_ = window_start_;
+          return false;
+        }
+        window_start_ = _offset;
+        window_end_ = _offset + kRead;
+      }
+      std::memcpy(&_msgSize, header_window_.data() + (_offset - window_start_), sizeof(_msgSize));
+      return true;
+    }
+
+    bool waitWritable() {
+      struct pollfd waitFd = {out_fd_, POLLOUT, 0};
+      return poll(&waitFd, 1, -1) >= 0 || errno == EINTR;
+    }
+
+    bool transfer(size_t _size) {
+      while (_size > 0) {
+        const ssize_t kSent = sendfile(out_fd_, in_fd_, &sent_, _size);
+        if (kSent > 0) {
+          _size -= static_cast<size_t>(kSent);
+        } else if (kSent < 0 && errno == EINTR) {
+          continue;
+        } else if (kSent < 0 && errno == EAGAIN) {
+          if (!waitWritable()) {
+            return false;
+          }
+        } else if (kSent < 0 && (errno == EINVAL || errno == ENOSYS)) {
+          return copy(_size);
+        } else {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool copy(size_t _size) {
+      uint8_t chunk[64 * 1024];
+      while (_size > 0) {
+        const size_t kChunkSize = _size < sizeof(chunk) ? _size : sizeof(chunk);
+        const ssize_t kRead = pread(in_fd_, chunk, kChunkSize, sent_);
+        if (kRead <= 0) {
+          return false;
+        }
+        ssize_t written = 0;
+        while (written < kRead) {
+          const ssize_t kWritten = write(out_fd_, chunk + written, static_cast<size_t>(kRead - written));
+          if (kWritten < 0) {
+            if (errno == EINTR) {
+              continue;
+            }
+            if (errno == EAGAIN && waitWritable()) {
+              continue;
+            }
+            sent_ += written;
+            return false;
+          }
+          written += kWritten;
+        }
+        sent_ += kRead;
+        _size -= static_cast<size_t>(kRead);
+      }
+      return true;
+    }
+
+    const int in_fd_;
+    const int out_fd_;
+    /**
+     * Offset of the next frame, only whole frames are committed to it
+     */
+    off_t offset_;
+    /**
+     * Offset up to which file is sent, it is ahead of offset_ if frame is sent partially
+     */
+    off_t sent_;
+    /**
+     * End of frame sent partially
+     */
+    off_t partial_end_;
+    const AlignMemory alignment_;
+    size_t num_frames_;
+    std::vector<uint8_t> header_window_;
+    off_t window_start_;
+    off_t window_end_;
+  };
+}
+
+#endif
+
+#endif //BUFFERS_FRAMEFORWARDER_HPP
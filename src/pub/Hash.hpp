@@ -0,0 +1,216 @@
+/**
+ * @file Hash.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains fast non-cryptographic hash of packed messages
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_HASH_HPP
+#define BUFFERS_HASH_HPP
+
+#include <stdint.h>
+#include <cstring>
+
+namespace buffers {
+  /**
+   * 128 bit hash of data
+   */
+  struct Hash128 {
+    uint64_t low;
+    uint64_t high;
+
+    bool operator==(const Hash128 & _other) const {
+      return low == _other.low && high == _other.high;
+    }
+
+    bool operator!=(const Hash128 & _other) const {
+      return !(*this == _other);
+    }
+  };
+
+  /**
+   * Streaming implementation of XXH64 hash.
+   * Data is consumed in stripes of 32 bytes by 4 independent lanes,
+   * so data could be fed by pieces of any size as it is packed
+   */
+  class Hash64 {
+   public:
+    explicit Hash64(const uint64_t _seed = 0) {
+      reset(_seed);
+    }
+
+    /**
+     * Method for restarting hash with seed
+     * @param _seed Seed of hash
+     */
+    void reset(const uint64_t _seed = 0) {
+      seed_ = _seed;
+      lanes_[0] = _seed + kPrime1 + kPrime2;
+      lanes_[1] = _seed + kPrime2;
+      lanes_[2] = _seed;
+      lanes_[3] = _seed - kPrime1;
+      total_size_ = 0;
+      stripe_size_ = 0;
+    }
+
+    /**
+     * Method for feeding data to hash
+     * @param _pData Pointer to the data
+     * @param _size Size of data
+     */
+    void update(uint8_t const * _pData, size_t _size) {
+      total_size_ += _size;
+      if (stripe_size_ + _size < kStripeSize) {
+        if (_size > 0) {
+          std::memcpy(stripe_ + stripe_size_, _pData, _size);
+        }
+        stripe_size_ += _size;
+        return;
+      }
+      if (stripe_size_ > 0) {
+        const size_t kFill = kStripeSize - stripe_size_;
+        std::memcpy(stripe_ + stripe_size_, _pData, kFill);
+        consumeStripe(stripe_);
+        _pData += kFill;
+        _size -= kFill;
+        stripe_size_ = 0;
+      }
+      while (_size >= kStripeSize) {
+        consumeStripe(_pData);
+        _pData += kStripeSize;
+        _size -= kStripeSize;
+      }
+      if (_size > 0) {
+        std::memcpy(stripe_, _pData, _size);
+      }
+      stripe_size_ = _size;
+    }
+
+    /**
+     * Method for getting hash of data fed so far.
+     * Does not change state, so feeding could be continued
+     * @return Hash of data
+     */
+    uint64_t digest() const {
+      uint64_t result;
+      if (total_size_ >= kStripeSize) {
+        result = rotl(lanes_[0], 1) + rotl(lanes_[1], 7) + rotl(lanes_[2], 12) + rotl(lanes_[3], 18);
+        for (size_t i = 0; i < 4; ++i) {
+          result = mergeLane(result, lanes_[i]);
+        }
+      } else {
+        result = seed_ + kPrime5;
+      }
+      result += total_size_;
+      size_t i = 0;
+      for (; i + 8 <= stripe_size_; i += 8) {
+        result ^= round(0, read64(stripe_ + i));
+        result = rotl(result, 27) * kPrime1 + kPrime4;
+      }
+      if (i + 4 <= stripe_size_) {
+        result ^= static_cast<uint64_t>(read32(stripe_ + i)) * kPrime1;
+        result = rotl(result, 23) * kPrime2 + kPrime3;
+        i += 4;
+      }
+      for (; i < stripe_size_; ++i) {
+        result ^= stripe_[i] * kPrime5;
+        result = rotl(result, 11) * kPrime1;
+      }
+      result ^= result >> 33;
+      result *= kPrime2;
+      result ^= result >> 29;
+      result *= kPrime3;
+      result ^= result >> 32;
+      return result;
+    }
+
+    /**
+     * Method for hashing data in one call
+     * @param _pData Pointer to the data
+     * @param _size Size of data
+     * @param _seed Seed of hash
+     * @return 64 bit hash of data
+     */
+    static uint64_t hash(uint8_t const * _pData, const size_t _size, const uint64_t _seed = 0) {
+      Hash64 hash(_seed);
+      hash.update(_pData, _size);
+      return hash.digest();
+    }
+
+    /**
+     * Method for hashing data to 128 bit hash.
+     * Halves of hash are XXH64 with different seeds, computed in one pass
+     * @param _pData Pointer to the data
+     * @param _size Size of data
+     * @param _seed Seed of hash
+     * @return 128 bit hash of data
+     */
+    static Hash128 hash128(uint8_t const * _pData, const size_t _size, const uint64_t _seed = 0) {
+      Hash64 low(_seed);
+      Hash64 high(_seed ^ kPrime3);
+      size_t offset = 0;
+      while (offset < _size) {
+        const size_t kChunkSize = _size - offset < kChunk128Size ? _size - offset : kChunk128Size;
+        low.update(_pData + offset, kChunkSize);
+        high.update(_pData + offset, kChunkSize);
+        offset += kChunkSize;
+      }
+      return Hash128{low.digest(), high.digest()};
+    }
+
+   private:
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+    static constexpr size_t kStripeSize = 32;
+    /**
+     * Size of chunk fed to both halves of 128 bit hash while it is in L1 cache
+     */
+    static constexpr size_t kChunk128Size = 4096;
+
+    static uint64_t rotl(const uint64_t _value, const int _bits) {
+      return (_value << _bits) | (_value >> (64 - _bits));
+    }
+
+    static uint64_t read64(uint8_t const * _pData) {
+      uint64_t result;
+      std::memcpy(&result, _pData, sizeof(result));
+      return result;
+    }
+
+    static uint32_t read32(uint8_t const * _pData) {
+      uint32_t result;
+      std::memcpy(&result, _pData, sizeof(result));
+      return result;
+    }
+
+    static uint64_t round(uint64_t _lane, const uint64_t _input) {
+      _lane += _input * kPrime2;
+      _lane = rotl(_lane, 31);
+      return _lane * kPrime1;
+    }
+
+    static uint64_t mergeLane(uint64_t _hash, const uint64_t _lane) {
+      _hash ^= round(0, _lane);
+      return _hash * kPrime1 + kPrime4;
+    }
+
+    void consumeStripe(uint8_t const * _pStripe) {
+      lanes_[0] = round(lanes_[0], read64(_pStripe));
+      lanes_[1] = round(lanes_[1], read64(_pStripe + 8));
+      lanes_[2] = round(lanes_[2], read64(_pStripe + 16));
+      lanes_[3] = round(lanes_[3], read64(_pStripe + 24));
+    }
+
+    uint64_t seed_;
+    uint64_t lanes_[4];
+    uint64_t total_size_;
+    size_t stripe_size_;
+    uint8_t stripe_[kStripeSize];
+  };
+}
+
+#endif //BUFFERS_HASH_HPP
@@ -20,8 +20,8 @@ namespace buffers {
 class HeapPackBuffer
     : public PackBuffer {
  public:
-  HeapPackBuffer(const size_t size)
-      : PackBuffer(new uint8_t[size]{0}, size) {
+  HeapPackBuffer(const size_t size, AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : PackBuffer(new uint8_t[size]{0}, size, _alignment) {
   }
 
   ~HeapPackBuffer() {
@@ -0,0 +1,246 @@
+/**
+ * @file MessageCoalescer.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains writer that coalesces packed messages into batches
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_MESSAGECOALESCER_HPP
+#define BUFFERS_MESSAGECOALESCER_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <stdint.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "BufferPool.hpp"
+#include "HeapPackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Writer that accumulates packed messages and writes them with one writev.
+   * Every message is written as frame: length of message followed by the
+   * packed message, so batches could be read by MessageScanner.
+   * For natural alignment frame is followed by zero padding up to the next header.
+   * Batch is flushed when limit of bytes or messages is reached, or when
+   * the oldest message in batch waits longer than allowed delay
+   */
+  class MessageCoalescer {
+   public:
+    /**
+     * Number of buckets in histogram of batch sizes
+     */
+    static constexpr size_t kNumHistogramBuckets = 16;
+
+    /**
+     * Constructor of coalescer
+     * @param _fd File descriptor for writing of batches
+     * @param _pool Pool of buffers for messages
+     * @param _maxBytes Size of batch in bytes after which batch is flushed
+     * @param _maxMessages Number of messages after which batch is flushed
+     * @param _maxDelay Maximum time the oldest message could wait in batch
+     */
+    MessageCoalescer(const int _fd, BufferPool & _pool,
+                     const size_t _maxBytes, const size_t _maxMessages,
+                     const std::chrono::microseconds _maxDelay)
+        : fd_{_fd}
+        , pool_(_pool)
+        , max_bytes_{_maxBytes}
+        , max_messages_{_maxMessages > 0 ? _maxMessages : 1}
+        , max_delay_{_maxDelay}
+        , batch_bytes_{0}
+        , num_flushes_{0}
+        , histogram_(kNumHistogramBuckets, 0) {
+      messages_.reserve(max_messages_);
+      headers_.reserve(max_messages_);
+      iovecs_.reserve(3 * max_messages_);
+    }
+
+    MessageCoalescer(const MessageCoalescer&) = delete;
+    MessageCoalescer& operator=(const MessageCoalescer&) = delete;
+
+    ~MessageCoalescer() {
+      flush();
+    }
+
+    /**
+     * Method for acquiring buffer for packing of the next message
+     * @return Buffer from pool
+     */
+    HeapPackBuffer * acquire() {
+      return pool_.acquire();
+    }
+
+    /**
+     * Method for adding packed message to batch.
+     * Batch is flushed if limits are reached or its deadline has already passed.
+     * Coalescer takes ownership of buffer and returns it to pool after writing
+     * @param _message Buffer with packed message acquired from this coalescer
+     * @return Return false if batch was flushed and writing is failed, true otherwise
+     */
+    bool submit(HeapPackBuffer * _message) {
+      if (messages_.empty()) {
+        batch_start_ = std::chrono::steady_clock::now();
+      }
+      messages_.push_back(_message);
+      headers_.push_back(_message->getDataSize());
+      batch_bytes_ += getAlignedSize(sizeof(size_t), _message->getAlignment()) + _message->getDataSize() +
+                      getPaddingSize(_message);
+      if (messages_.size() >= max_messages_ || batch_bytes_ >= max_bytes_ ||
+          getDeadline() <= std::chrono::steady_clock::now()) {
+        return flush();
+      }
+      return true;
+    }
+
+    /**
+     * Method for flushing batch if its oldest message waits longer than allowed delay.
+     * Should be called periodically when no new messages are submitted
+     * @return Return false if batch was flushed and writing is failed, true otherwise
+     */
+    bool poll() {
+      if (!messages_.empty() && getDeadline() <= std::chrono::steady_clock::now()) {
+        return flush();
+      }
+      return true;
+    }
+
+    /**
+     * Method for getting time until which batch should be flushed
+     * @return Deadline of batch
+     */
+    std::chrono::steady_clock::time_point getDeadline() const {
+      return batch_start_ + max_delay_;
+    }
+
+    /**
+     * Method for writing all accumulated messages
+     * @return Return true if writing is succeed, false otherwise
+     */
+    bool flush() {
+      if (messages_.empty()) {
+        return true;
+      }
+      iovecs_.clear();
+      for (size_t i = 0; i < messages_.size(); ++i) {
+        iovecs_.push_back({&headers_[i], getAlignedSize(sizeof(size_t), messages_[i]->getAlignment())});
+        iovecs_.push_back({const_cast<uint8_t *>(messages_[i]->getData()), messages_[i]->getDataSize()});
+        const size_t kPaddingSize = getPaddingSize(messages_[i]);
+        if (kPaddingSize > 0) {
+          static const uint8_t kPadding[alignof(size_t)] = {0};
+          iovecs_.push_back({const_cast<uint8_t *>(kPadding), kPaddingSize});
+        }
+      }
+      const bool kResult = writeAll();
+      ++histogram_[getHistogramBucket(messages_.size())];
+      ++num_flushes_;
+      for (auto message : messages_) {
+        pool_.release(message);
+      }
+      messages_.clear();
+      headers_.clear();
+      batch_bytes_ = 0;
+      return kResult;
+    }
+
+    /**
+     * Method for getting histogram of number of messages in flushed batches.
+     * Bucket i contains number of batches with [2^i, 2^(i+1)) messages
+     * @return Histogram of batch sizes
+     */
+    const std::vector<size_t> & getBatchHistogram() const {
+      return histogram_;
+    }
+
+    /**
+     * Method for getting number of flushed batches
+     * @return Number of flushed batches
+     */
+    size_t getNumFlushes() const {
+      return num_flushes_;
+    }
+
+    /**
+     * Method for getting number of messages waiting in batch
+     * @return Number of messages in batch
+     */
+    size_t getNumPending() const {
+      return messages_.size();
+    }
+
+   private:
+    /**
+     * For natural alignment the next frame header should start at boundary of size_t
+     */
+    static size_t getPaddingSize(const HeapPackBuffer * _message) {
+      const size_t kDataSize = _message->getDataSize();
+      return getAlignedOffset(kDataSize, alignof(size_t), _message->getAlignment()) - kDataSize;
+    }
+
+    static size_t getHistogramBucket(size_t _numMessages) {
+      size_t bucket = 0;
+      while (_numMessages > 1 && bucket + 1 < kNumHistogramBuckets) {
+        _numMessages >>= 1;
+        ++bucket;
+      }
+      return bucket;
+    }
+
+    bool waitWritable() {
+      struct pollfd waitFd = {fd_, POLLOUT, 0};
+      return ::poll(&waitFd, 1, -1) >= 0 || errno == EINTR;
+    }
+
+    bool writeAll() {
+      size_t first = 0;
+      while (first < iovecs_.size()) {
+        const size_t kNumVecs = std::min<size_t>(iovecs_.size() - first, IOV_MAX);
+        const ssize_t kWritten = writev(fd_, &iovecs_[first], static_cast<int>(kNumVecs));
+        if (kWritten < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          if (errno == EAGAIN && waitWritable()) {
+            continue;
+          }
+          return false;
+        }
+        size_t written = static_cast<size_t>(kWritten);
+        while (first < iovecs_.size() && written >= iovecs_[first].iov_len) {
+          written -= iovecs_[first].iov_len;
+          ++first;
+        }
+        if (written > 0) {
+          iovecs_[first].iov_base = static_cast<uint8_t *>(iovecs_[first].iov_base) + written;
+          iovecs_[first].iov_len -= written;
+        }
+      }
+      return true;
+    }
+
+    const int fd_;
+    BufferPool & pool_;
+    const size_t max_bytes_;
+    const size_t max_messages_;
+    const std::chrono::microseconds max_delay_;
+    std::chrono::steady_clock::time_point batch_start_;
+    size_t batch_bytes_;
+    size_t num_flushes_;
+    std::vector<HeapPackBuffer *> messages_;
+    std::vector<size_t> headers_;
+    std::vector<struct iovec> iovecs_;
+    std::vector<size_t> histogram_;
+  };
+}
+
+#endif
+
+#endif //BUFFERS_MESSAGECOALESCER_HPP
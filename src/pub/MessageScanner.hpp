@@ -0,0 +1,139 @@
+/**
+ * @file MessageScanner.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains scanner with predicate pushdown and projection over batch of packed messages
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_MESSAGESCANNER_HPP
+#define BUFFERS_MESSAGESCANNER_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <algorithm>
+
+#include "AlignMemory.hpp"
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Scanner over batch of framed messages.
+   * Every frame is length of message followed by the packed message, exactly
+   * as it is written by PackBuffer::put(message.getData(), message.getDataSize()).
+   * For natural alignment frame also includes padding up to the next header.
+   * Predicate and projection decode only fields they need, the rest of message
+   * is skipped by the length of frame
+   */
+  class MessageScanner {
+   public:
+    /**
+     * Constructor of scanner over batch of frames
+     * @param _pBatch Pointer to the first frame
+     * @param _size Size of batch
+     * @param _alignment Alignment with which frames are packed
+     */
+    MessageScanner(uint8_t const * const _pBatch, const size_t _size,
+                   AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+        : p_batch_{_pBatch}
+        , size_{_size}
+        , alignment_{_alignment} {
+    }
+
+    /**
+     * Method for visiting every message in the batch
+     * @param _visitor Callable with signature void(UnpackBuffer & message)
+     * @return Number of visited messages
+     */
+    template <typename TVisitor>
+    size_t scan(TVisitor _visitor) const {
+      return forEachFrame([&_visitor](UnpackBuffer & _msg, uint8_t const *, size_t) {
+        _visitor(_msg);
+      });
+    }
+
+    /**
+     * Method for copying verbatim frames of messages matched by predicate.
+     * For natural alignment every copied frame starts at aligned header, so frames
+     * of several batches could be filtered into the same buffer
+     * @param _out Buffer for matched frames
+     * @param _predicate Callable with signature bool(UnpackBuffer & message),
+     *                   it should unpack only leading fields it needs
+     * @return Number of copied messages
+     */
+    template <typename TPredicate>
+    size_t filter(PackBuffer & _out, TPredicate _predicate) const {
+      size_t numCopied = 0;
+      forEachFrame([&](UnpackBuffer & _msg, uint8_t const * _pFrame, size_t _frameSize) {
+        if (_predicate(_msg)) {
+          const size_t kFrameStart = _out.getDataSize();
+          if (_out.align(alignof(size_t)) && _out.putRaw(_pFrame, _frameSize)) {
+            ++numCopied;
+          } else {
+            _out.rollback(kFrameStart);
+          }
+        }
+      });
+      return numCopied;
+    }
+
+    /**
+     * Method for packing projection of messages matched by predicate.
+     * Every projection is packed as separate frame. If projection fails or does not fit in _out,
+     * its frame is rolled back and scanning continues with the next message
+     * @param _out Buffer for frames of projections
+     * @param _predicate Callable with signature bool(UnpackBuffer & message)
+     * @param _projection Callable with signature bool(UnpackBuffer & message, PackBuffer & out),
+     *                    called with message positioned after fields read by predicate
+     * @return Number of projected messages
+     */
+    template <typename TPredicate, typename TProjection>
+    size_t project(PackBuffer & _out, TPredicate _predicate, TProjection _projection) const {
+      size_t numProjected = 0;
+      forEachFrame([&](UnpackBuffer & _msg, uint8_t const *, size_t) {
+        if (_predicate(_msg)) {
+          const size_t kFrameStart = _out.getDataSize();
+          auto frameSize = _out.putField<size_t>(0);
+          const size_t kStart = _out.getDataSize();
+          if (frameSize.isValid() && _projection(_msg, _out) &&
+              _out.patch(frameSize, _out.getDataSize() - kStart)) {
+            ++numProjected;
+          } else {
+            _out.rollback(kFrameStart);
+          }
+        }
+      });
+      return numProjected;
+    }
+
+   private:
+    template <typename TFrameHandler>
+    size_t forEachFrame(TFrameHandler _handler) const {
+      const size_t kHeaderSize = getAlignedSize(sizeof(size_t), alignment_);
+      size_t numFrames = 0;
+      size_t offset = 0;
+      while (size_ - offset >= kHeaderSize) {
+        size_t msgSize;
+        std::memcpy(&msgSize, p_batch_ + offset, sizeof(msgSize));
+        if (msgSize > size_ - offset - kHeaderSize) {
+          break;
+        }
+        const size_t kFrameEnd = getAlignedOffset(offset + kHeaderSize + getAlignedSize(msgSize, alignment_),
+                                                  alignof(size_t), alignment_);
+        const size_t kFrameSize = std::min(kFrameEnd, size_) - offset;
+        UnpackBuffer msg(p_batch_ + offset + kHeaderSize, msgSize, alignment_);
+        _handler(msg, p_batch_ + offset, kFrameSize);
+        offset += kFrameSize;
+        ++numFrames;
+      }
+      return numFrames;
+    }
+
+    uint8_t const * const p_batch_;
+    const size_t size_;
+    const AlignMemory alignment_;
+  };
+}
+
+#endif //BUFFERS_MESSAGESCANNER_HPP
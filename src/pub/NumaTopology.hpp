@@ -0,0 +1,122 @@
+/**
+ * @file NumaTopology.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains detection of NUMA nodes and node of the current thread
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_NUMATOPOLOGY_HPP
+#define BUFFERS_NUMATOPOLOGY_HPP
+
+#include <stdint.h>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace buffers {
+  /**
+   * NUMA topology of machine read from /sys/devices/system/node.
+   * Nodes listed in file "online" are numbered densely in the order of the list,
+   * so node ids with gaps do not leave empty nodes.
+   * On machines without NUMA or without sysfs topology has one node
+   */
+  class NumaTopology {
+   public:
+    /**
+     * Method for getting topology of machine, detected once
+     * @return Topology of machine
+     */
+    static const NumaTopology & get() {
+      static const NumaTopology kTopology("/sys/devices/system/node");
+      return kTopology;
+    }
+
+    /**
+     * Constructor of topology
+     * @param _nodesPath Path to directory with file "online" and directories nodeN with file "cpulist"
+     */
+    explicit NumaTopology(const std::string & _nodesPath)
+        : num_nodes_{1} {
+      std::ifstream onlineFile(_nodesPath + "/online");
+      std::string nodes;
+      if (!std::getline(onlineFile, nodes)) {
+        return;
+      }
+      const std::vector<size_t> kNodeIds = parseList(nodes);
+      for (size_t node = 0; node < kNodeIds.size(); ++node) {
+        std::ifstream cpuListFile(_nodesPath + "/node" + std::to_string(kNodeIds[node]) + "/cpulist");
+        std::string cpus;
+        std::getline(cpuListFile, cpus);
+        for (const size_t kCpu : parseList(cpus)) {
+          if (cpu_nodes_.size() <= kCpu) {
+            cpu_nodes_.resize(kCpu + 1, 0);
+          }
+          cpu_nodes_[kCpu] = node;
+        }
+      }
+      if (!kNodeIds.empty()) {
+        num_nodes_ = kNodeIds.size();
+      }
+    }
+
+    /**
+     * Method for getting number of NUMA nodes
+     * @return Number of nodes, at least 1
+     */
+    size_t getNumNodes() const {
+      return num_nodes_;
+    }
+
+    /**
+     * Method for getting node of CPU on which the current thread runs
+     * @return Index of node among online nodes, 0 if it is unknown
+     */
+    size_t getCurrentNode() const {
+#ifdef __linux__
+      if (num_nodes_ > 1) {
+        const int kCpu = sched_getcpu();
+        if (kCpu >= 0 && static_cast<size_t>(kCpu) < cpu_nodes_.size()) {
+          return cpu_nodes_[kCpu];
+        }
+      }
+#endif
+      return 0;
+    }
+
+   private:
+    /**
+     * Method for parsing list of ids in format "0-3,8-11"
+     */
+    static std::vector<size_t> parseList(const std::string & _ranges) {
+      std::vector<size_t> ids;
+      std::istringstream rangesStream(_ranges);
+      std::string range;
+      while (std::getline(rangesStream, range, ',')) {
+        if (range.empty() || range[0] < '0' || range[0] > '9') {
+          continue;
+        }
+        const size_t kDash = range.find('-');
+        const size_t kFirst = std::strtoul(range.c_str(), nullptr, 10);
+        const size_t kLast = kDash == std::string::npos
+                             ? kFirst
+                             : std::strtoul(range.c_str() + kDash + 1, nullptr, 10);
+        for (size_t id = kFirst; id <= kLast; ++id) {
+          ids.push_back(id);
+        }
+      }
+      return ids;
+    }
+
+    size_t num_nodes_;
+    std::vector<size_t> cpu_nodes_;
+  };
+}
+
+#endif //BUFFERS_NUMATOPOLOGY_HPP
@@ -11,19 +11,96 @@
 
 #include <stdint.h>
 #include <cstring>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <list>
 #include <set>
 #include <map>
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 #include <algorithm>
 #include <type_traits>
 
 #include "AlignMemory.hpp"
+#include "CopyEngine.hpp"
+#include "Hash.hpp"
+#include "CompactCode.hpp"
+#include "TypeTag.hpp"
 
 namespace buffers {
+  /**
+   * Handle of fixed size field packed in the buffer.
+   * Holds offset of the field from the beginning of the message and
+   * allows to overwrite the field in place without repacking of message
+   * @tparam T Type of field. Should be a trivial type
+   */
+  template <typename T>
+  class FieldHandle {
+#if __cplusplus > 199711L
+    static_assert(std::is_trivial<T>::value, "Type T is not a trivial type !!");
+#endif
+
+   public:
+    typedef T value_type;
+
+    FieldHandle()
+        : offset_{std::numeric_limits<size_t>::max()} {
+    }
+
+    explicit FieldHandle(const size_t _offset)
+        : offset_{_offset} {
+    }
+
+    /**
+     * Method for checking if field was packed successfully
+     * @return true if handle points to the packed field, false otherwise
+     */
+    bool isValid() const {
+      return offset_ != std::numeric_limits<size_t>::max();
+    }
+
+    /**
+     * Method for getting offset of the field from the beginning of message
+     * @return Offset of the field
+     */
+    size_t offset() const {
+      return offset_;
+    }
+
+    /**
+     * Method for overwriting the field in packed message
+     * @param _pMsg Pointer to the packed message or its copy
+     * @param _msgSize Size of the packed message
+     * @param _t New value of the field
+     * @return Return true if patching is succeed, false otherwise
+     */
+    bool patch(uint8_t * const _pMsg, const size_t _msgSize, const T & _t) const {
+      bool result = false;
+      if (_pMsg && isValid() && offset_ + sizeof(T) <= _msgSize) {
+        std::memcpy(_pMsg + offset_, &_t, sizeof(T));
+        result = true;
+      }
+      return result;
+    }
+
+    /**
+     * Method for reading the field from packed message
+     * @param _pMsg Pointer to the packed message or its copy
+     * @return Value of the field
+     */
+    T read(uint8_t const * const _pMsg) const {
+      T result;
+      std::memcpy(&result, _pMsg + offset_, sizeof(T));
+      return result;
+    }
+
+   private:
+    size_t offset_;
+  };
+
   /**
    * Pack buffer class
    */
@@ -50,9 +127,14 @@ namespace buffers {
         }
 #endif
 
-        const uint32_t kAlignedSize = getAlignedSize(_size);
-        p_msg_ += kAlignedSize;
-        msg_size_ += kAlignedSize;
+        const size_t kAlignedSize = getAlignedSize(_size);
+        if (kAlignedSize > _size) {
+          const size_t kPaddingEnd = std::min(kAlignedSize, buf_size_ - msg_size_);
+          if (kPaddingEnd > _size) {
+            std::fill(p_msg_ + _size, p_msg_ + kPaddingEnd, 0);
+          }
+        }
+        advance(kAlignedSize);
         return *this;
       }
 
@@ -63,9 +145,15 @@ namespace buffers {
         }
 #endif
 
-        const uint32_t kAlignedSize = getAlignedSize(_size);
+        const size_t kAlignedSize = getAlignedSize(_size);
         p_msg_ -= kAlignedSize;
         msg_size_ -= kAlignedSize;
+        if (msg_size_ < hashed_size_) {
+          restartHash();
+        }
+        while (!shared_offsets_.empty() && shared_offsets_.back() >= msg_size_) {
+          removeShared(shared_ptrs_.size());
+        }
         return *this;
       }
 
@@ -77,24 +165,170 @@ namespace buffers {
         return (buf_size_ - msg_size_);
       }
 
+      AlignMemory alignment() const {
+        return alignment_;
+      }
+
+      /**
+       * Method for getting offset of the next position from the beginning of the message
+       * @return Offset of the next position
+       */
+      size_t offset() const {
+        return msg_size_;
+      }
+
+      /**
+       * Method for checking if array of trivial type should be placed at array boundary
+       * @param _size Size of array payload in bytes
+       * @return true if array payload is preceded by flagged number of elements and recorded padding,
+       *         false otherwise
+       */
+      bool isArrayAligned(const size_t _size) const {
+        return array_boundary_ != 0 && _size >= array_threshold_;
+      }
+
+      size_t arrayBoundary() const {
+        return array_boundary_;
+      }
+
+      /**
+       * Method for checking if unordered containers are packed in canonical order
+       * @return true if elements are packed sorted by key, false otherwise
+       */
+      bool isCanonical() const {
+        return canonical_;
+      }
+
+      /**
+       * Method for getting id of shared object already packed in the message.
+       * Objects of different types at the same address, for example object and its first member,
+       * are different shared objects
+       * @param _ptr Pointer to shared object
+       * @param _type Tag of type of shared object
+       * @return Id of shared object, 0 if object is not packed yet
+       */
+      size_t sharedId(const void * _ptr, const void * _type) const {
+        auto found = shared_ids_.find(SharedKey(_ptr, _type));
+        return found != shared_ids_.end() ? found->second : 0;
+      }
+
+      /**
+       * Method for registering shared object packed in the message
+       * @param _ptr Pointer to shared object
+       * @param _type Tag of type of shared object
+       * @return Id of shared object, ids start from 1
+       */
+      size_t addShared(const void * _ptr, const void * _type) {
+        shared_ptrs_.emplace_back(_ptr, _type);
+        shared_offsets_.push_back(msg_size_);
+        shared_ids_[shared_ptrs_.back()] = shared_ptrs_.size();
+        return shared_ptrs_.size();
+      }
+
+      /**
+       * Method for forgetting shared objects registered starting from _id,
+       * used when packing of shared object is rolled back.
+       * Objects registered in data released by operator -= are forgotten automatically
+       * @param _id Id of the first forgotten shared object
+       */
+      void removeShared(const size_t _id) {
+        while (shared_ptrs_.size() >= _id && !shared_ptrs_.empty()) {
+          shared_ids_.erase(shared_ptrs_.back());
+          shared_ptrs_.pop_back();
+          shared_offsets_.pop_back();
+        }
+      }
+
+      /**
+       * Method for moving next position in the message to the boundary of
+       * type alignment. Padding is filled with zeros.
+       * Does something only for natural alignment of memory
+       * @param _typeAlignment Alignment of type of the next value, alignof(T)
+       * @param _size Size of the next value, it should fit in the buffer after padding
+       * @return Return true if padding and the next value fit in the buffer, false otherwise
+       */
+      bool align(const size_t _typeAlignment, const size_t _size = 0) {
+        const size_t kPadding = getAlignedOffset(msg_size_, _typeAlignment, alignment_) - msg_size_;
+        if (kPadding + getAlignedSize(_size) > buffer_size()) {
+          return false;
+        }
+        std::fill(p_msg_, p_msg_ + kPadding, 0);
+        advance(kPadding);
+        return true;
+      }
+
+      /**
+       * Method for rewriting data already packed in the message, for example size
+       * known only after packing of the following data
+       * @param _pData Position in the message
+       * @param _pValue Pointer to the new data
+       * @param _size Size of the new data
+       */
+      void patch(uint8_t * _pData, const void * _pValue, const size_t _size) {
+        std::memcpy(_pData, _pValue, _size);
+        if (static_cast<size_t>(_pData - (p_msg_ - msg_size_)) < hashed_size_) {
+          restartHash();
+        }
+      }
+
      private:
       Context(uint8_t * _pMsg, size_t _size, AlignMemory _alignment)
           : buf_size_{_size}
           , p_msg_{_pMsg}
           , msg_size_{0}
-          , alignment_{_alignment} {
+          , alignment_{_alignment}
+          , array_boundary_{0}
+          , array_threshold_{0}
+          , canonical_{false}
+          , hashing_{false}
+          , hash_seed_{0}
+          , hashed_size_{0} {
       }
 
-      uint32_t getAlignedSize(const size_t & _size) const {
-        const auto kAlignedMemChunk = static_cast<uint32_t>(alignment_);
-        const uint32_t kNumChunks = _size / kAlignedMemChunk + (_size % kAlignedMemChunk == 0 ? 0 : 1);
-        return kNumChunks * kAlignedMemChunk;
+      void advance(const size_t _size) {
+        if (hashing_ && hashed_size_ == msg_size_) {
+          hash_.update(p_msg_, _size);
+          hashed_size_ += _size;
+        }
+        p_msg_ += _size;
+        msg_size_ += _size;
+      }
+
+      /**
+       * Incremental hash could not be rolled back, so it is restarted
+       * and continued only after reset of buffer
+       */
+      void restartHash() {
+        hash_.reset(hash_seed_);
+        hashed_size_ = 0;
+      }
+
+      size_t getAlignedSize(const size_t & _size) const {
+        return buffers::getAlignedSize(_size, alignment_);
       }
 
       const size_t buf_size_;
       uint8_t * p_msg_;
       size_t msg_size_;
       AlignMemory alignment_;
+      size_t array_boundary_;
+      size_t array_threshold_;
+      bool canonical_;
+      bool hashing_;
+      uint64_t hash_seed_;
+      size_t hashed_size_;
+      Hash64 hash_;
+      typedef std::pair<const void *, const void *> SharedKey;
+
+      struct SharedKeyHash {
+        size_t operator()(const SharedKey & _key) const {
+          return std::hash<const void *>{}(_key.first) ^ (std::hash<const void *>{}(_key.second) << 1);
+        }
+      };
+
+      std::unordered_map<SharedKey, size_t, SharedKeyHash> shared_ids_;
+      std::vector<SharedKey> shared_ptrs_;
+      std::vector<size_t> shared_offsets_;
     };
 
     /**
@@ -161,6 +395,79 @@ namespace buffers {
       return result;
     }
 
+    /**
+     * Method for packing elements placed at equal distance, for example one field
+     * from array of structs or one column of row-major matrix.
+     * Packed exactly as put(const T *, size_t) of continuous elements
+     * @tparam T Type of elements. Should be a trivial type
+     * @param _base Pointer to the first element
+     * @param _count Number of elements
+     * @param _stride Distance between elements in bytes
+     * @return Return true if packing is succeed, false otherwise
+     */
+    template<typename T>
+    bool putStrided(const T * _base, const size_t _count, const size_t _stride) {
+      return DelegatePackBuffer<T>{}.putStrided(context_, _base, _count, _stride);
+    }
+
+    /**
+     * Method for packing already packed bytes verbatim
+     * @param _data Pointer to the packed bytes
+     * @param _size Size of the packed bytes
+     * @return Return true if packing is succeed, false otherwise
+     */
+    bool putRaw(uint8_t const * _data, const size_t _size) {
+      bool result = false;
+      if (_data && context_.getAlignedSize(_size) <= context_.buffer_size()) {
+        CopyEngine::copy(context_.buffer(), _data, _size);
+        context_ += _size;
+        result = true;
+      }
+      return result;
+    }
+
+    /**
+     * Method for moving next position to the boundary of type alignment, for example
+     * before verbatim bytes of packed value. Padding is filled with zeros.
+     * Does something only for natural alignment of memory
+     * @param _typeAlignment Alignment of type of the next value, alignof(T)
+     * @return Return true if padding fits in the buffer, false otherwise
+     */
+    bool align(const size_t _typeAlignment) {
+      return context_.align(_typeAlignment);
+    }
+
+    /**
+     * Method for packing fixed size field with remembering of its position
+     * @tparam T Type of field. Should be a trivial type
+     * @param _t Field for packing
+     * @return Handle of packed field, invalid handle if packing is failed
+     */
+    template<typename T>
+    FieldHandle<T> putField(const T & _t) {
+      if (DelegatePackBuffer<T>{}.put(context_, _t)) {
+        return FieldHandle<T>(getDataSize() - buffers::getAlignedSize(sizeof(T), context_.alignment()));
+      }
+      return FieldHandle<T>();
+    }
+
+    /**
+     * Method for overwriting in place of previously packed field
+     * @tparam T Type of field
+     * @param _handle Handle of field returned by putField
+     * @param _t New value of field, converted to type of field
+     * @return Return true if patching is succeed, false otherwise
+     */
+    template<typename T>
+    bool patch(const FieldHandle<T> & _handle, const typename FieldHandle<T>::value_type & _t) {
+      bool result = false;
+      if (_handle.isValid() && _handle.offset() + sizeof(T) <= getDataSize()) {
+        context_.patch(p_buf_ + _handle.offset(), &_t, sizeof(T));
+        result = true;
+      }
+      return result;
+    }
+
     template< typename T >
     static size_t getTypeSize() {
       return DelegatePackBuffer<T>{}.getTypeSize();
@@ -176,16 +483,105 @@ namespace buffers {
       return DelegatePackBuffer<T>{}.getTypeSize(_array);
     }
 
+    template< size_t dataLen >
+    static size_t getTypeSize(const char (&_str)[dataLen]);
+
     template< typename T >
     static size_t getTypeSize(const T * _t, size_t dataLen) {
       return DelegatePackBuffer<T>{}.getTypeSize(_t, dataLen);
     }
 
+    /**
+     * Method for enabling placement of large arrays of trivial type at array boundary.
+     * Payload of std::vector or raw array with size not less than _threshold
+     * is preceded by recorded padding, so it starts at offset multiple of _boundary.
+     * Number of elements of such array is packed with kArrayPaddingFlag and followed by size of padding,
+     * so UnpackBuffer and framed messages do not need to know about this option
+     * @param _boundary Boundary of array payload, power of two (32 for AVX, 64 for cache line),
+     *                  0 disables placement at array boundary
+     * @param _threshold Size of array payload in bytes from which it is placed at boundary
+     * @return Return true if option is set, false if _boundary is not a power of two
+     */
+    bool setArrayAlignment(const size_t _boundary, const size_t _threshold) {
+      if ((_boundary & (_boundary - 1)) != 0 ||
+          (_boundary != 0 && _boundary < buffers::getAlignedSize(1, context_.alignment()))) {
+        return false;
+      }
+      context_.array_boundary_ = _boundary;
+      context_.array_threshold_ = _threshold;
+      return true;
+    }
+
+    /**
+     * Method for enabling canonical encoding of unordered containers.
+     * Elements of std::unordered_set and std::unordered_map are packed sorted by key,
+     * so equal containers are always packed to the same bytes.
+     * Wire format is the same, UnpackBuffer does not need to know about this option
+     * @param _canonical true to pack elements sorted by key, false to pack in iteration order
+     */
+    void setCanonical(const bool _canonical) {
+      context_.canonical_ = _canonical;
+    }
+
+    /**
+     * Method for enabling hashing of message while it is packed.
+     * Every packed value is fed to XXH64 right after it is written,
+     * so getHash() does not need additional pass over the message.
+     * Rollback or patching of packed data restarts hashing, in this case
+     * getHash() hashes the whole message until reset()
+     * @param _seed Seed of hash
+     */
+    void enableHashing(const uint64_t _seed = 0) {
+      context_.hashing_ = true;
+      context_.hash_seed_ = _seed;
+      context_.restartHash();
+      if (context_.msg_size_ > 0) {
+        context_.hashed_size_ = context_.msg_size_;
+        context_.hash_.update(p_buf_, context_.msg_size_);
+      }
+    }
+
+    /**
+     * Method for getting 64 bit hash of packed message.
+     * Padding is always zeroed, so equal values are hashed equally
+     * @return XXH64 hash of packed message with seed set by enableHashing()
+     */
+    uint64_t getHash() const {
+      if (context_.hashing_ && context_.hashed_size_ == context_.msg_size_) {
+        return context_.hash_.digest();
+      }
+      return Hash64::hash(p_buf_, context_.msg_size_, context_.hashing_ ? context_.hash_seed_ : 0);
+    }
+
+    /**
+     * Method for getting 128 bit hash of packed message
+     * @return 128 bit hash of packed message
+     */
+    Hash128 getHash128() const {
+      return Hash64::hash128(p_buf_, context_.msg_size_, context_.hashing_ ? context_.hash_seed_ : 0);
+    }
+
     /**
      * Method for reset packing data to the buffer
      */
     void reset() {
       context_ -= context_.msg_size_;
+      context_.restartHash();
+      context_.shared_ids_.clear();
+      context_.shared_ptrs_.clear();
+      context_.shared_offsets_.clear();
+    }
+
+    /**
+     * Method for discarding data packed after the given size of data, for example
+     * when values that should be packed together do not fit in the buffer.
+     * Shared objects first packed in discarded data are forgotten
+     * @param _dataSize Size of data returned by getDataSize() before packing of discarded data
+     */
+    void rollback(const size_t _dataSize) {
+      if (_dataSize < context_.msg_size_) {
+        context_ -= context_.msg_size_ - _dataSize;
+      }
     }
 
     /**
@@ -220,9 +616,198 @@ namespace buffers {
       return context_.buffer_size();
     }
 
+    /**
+     * Method for getting alignment of packed buffer
+     * @return Alignment of packed buffer
+     */
+    AlignMemory getAlignment() const {
+      return context_.alignment();
+    }
+
    protected:
     uint8_t * const p_buf_;
     Context context_;
+
+   private:
+    /**
+     * Number of elements below which comparison sort is faster than radix sort
+     */
+    static constexpr size_t kRadixSortThreshold = 64;
+
+    /**
+     * Method for sorting pointers to elements by integral key with LSD radix sort.
+     * Passes over bytes that are the same for all keys are skipped
+     */
+    template <typename TKey, typename TElement, typename TGetKey>
+    static typename std::enable_if<(std::is_integral<TKey>::value && !std::is_same<TKey, bool>::value)>::type
+    sortByKey(std::vector<TElement const *> & _elements, TGetKey _getKey) {
+      const size_t kSize = _elements.size();
+      if (kSize < kRadixSortThreshold) {
+        std::sort(_elements.begin(), _elements.end(), [&_getKey](TElement const * _lhs, TElement const * _rhs) {
+          return _getKey(*_lhs) < _getKey(*_rhs);
+        });
+        return;
+      }
+      typedef typename std::make_unsigned<TKey>::type TRadix;
+      const TRadix kSignFlip = std::is_signed<TKey>::value
+                               ? static_cast<TRadix>(TRadix(1) << (sizeof(TKey) * 8 - 1))
+                               : TRadix(0);
+      std::vector<std::pair<TRadix, TElement const *>> items(kSize);
+      std::vector<std::pair<TRadix, TElement const *>> sorted(kSize);
+      for (size_t i = 0; i < kSize; ++i) {
+        items[i] = std::make_pair(static_cast<TRadix>(static_cast<TRadix>(_getKey(*_elements[i])) ^ kSignFlip),
+                                  _elements[i]);
+      }
+      for (size_t shift = 0; shift < sizeof(TKey) * 8; shift += 8) {
+        size_t offsets[256] = {0};
+        for (const auto & item : items) {
+          ++offsets[(item.first >> shift) & 0xFF];
+        }
+        if (offsets[(items[0].first >> shift) & 0xFF] == kSize) {
+          continue;
+        }
+        size_t offset = 0;
+        for (size_t & bucket : offsets) {
+          const size_t kCount = bucket;
+          bucket = offset;
+          offset += kCount;
+        }
+        for (const auto & item : items) {
+          sorted[offsets[(item.first >> shift) & 0xFF]++] = item;
+        }
+        items.swap(sorted);
+      }
+      for (size_t i = 0; i < kSize; ++i) {
+        _elements[i] = items[i].second;
+      }
+    }
+
+    /**
+     * Method for sorting pointers to elements by non integral key with comparison sort
+     */
+    template <typename TKey, typename TElement, typename TGetKey>
+    static typename std::enable_if<!(std::is_integral<TKey>::value && !std::is_same<TKey, bool>::value)>::type
+    sortByKey(std::vector<TElement const *> & _elements, TGetKey _getKey) {
+      std::sort(_elements.begin(), _elements.end(), [&_getKey](TElement const * _lhs, TElement const * _rhs) {
+        return _getKey(*_lhs) < _getKey(*_rhs);
+      });
+    }
+
+    /**
+     * Method for packing elements of unordered container sorted by key.
+     * Only pointers to elements are sorted, elements are not copied
+     * @param _ctx Context of buffer
+     * @param _pStart Position of context before packing of container
+     * @param _container Container for packing
+     * @param _getKey Callable that returns key of element
+     * @param _putElement Callable that packs one element
+     * @return Return true if packing is succeed, false otherwise
+     */
+    template <typename TBufferContext, typename TContainer, typename TGetKey, typename TPutElement>
+    static bool putSortedElements(TBufferContext & _ctx, uint8_t * _pStart, const TContainer & _container,
+                                  TGetKey _getKey, TPutElement _putElement) {
+      typedef typename TContainer::value_type TElement;
+      typedef typename std::decay<decltype(_getKey(*_container.begin()))>::type TKey;
+      std::vector<TElement const *> elements;
+      elements.reserve(_container.size());
+      for (const auto & element : _container) {
+        elements.push_back(&element);
+      }
+      sortByKey<TKey>(elements, _getKey);
+      return putElements(_ctx, _pStart, elements, [&_putElement](TBufferContext & _elemCtx, TElement const * _element) {
+        return _putElement(_elemCtx, *_element);
+      });
+    }
+
+    /**
+     * Method for packing number of elements of array of trivial type.
+     * If array payload is placed at array boundary, number is packed with kArrayPaddingFlag
+     * and followed by padding recorded as size_t and zero bytes of padding
+     * @param _ctx Context of buffer
+     * @param _count Number of elements of array
+     * @param _size Size of array payload in bytes
+     * @return Return true if number, padding and payload fit in buffer, false otherwise
+     */
+    template <typename TBufferContext>
+    static bool putArrayCount(TBufferContext & _ctx, const size_t _count, const size_t _size);
+
+    /**
+     * Method for packing elements of node based container in one pass.
+     * In PUB_COMPACT_CODE mode elements are packed by shared putElementsShared.
+     * If some element does not fit in buffer, context is rolled back to _pStart
+     * @param _ctx Context of buffer
+     * @param _pStart Position of context before packing of container
+     * @param _container Container for packing
+     * @param _putElement Callable that packs one element
+     * @return Return true if packing is succeed, false otherwise
+     */
+#ifdef PUB_COMPACT_CODE
+    template <typename TBufferContext, typename TContainer, typename TPutElement>
+    static bool putElements(TBufferContext & _ctx, uint8_t * _pStart,
+                            const TContainer & _container, TPutElement _putElement) {
+      struct Iterator {
+        typename TContainer::const_iterator it;
+        TPutElement & putElement;
+      };
+      Iterator iterator{_container.begin(), _putElement};
+      return putElementsShared(_ctx, _pStart, _container.size(), &iterator, [](Context & _elemCtx, void * _iterator) {
+        Iterator & iterator = *static_cast<Iterator *>(_iterator);
+        return iterator.putElement(_elemCtx, *iterator.it++);
+      });
+    }
+
+    /**
+     * Method for packing elements of any node based container, shared by all types of containers.
+     * Only _putNext is instantiated for every type
+     * @param _ctx Context of buffer
+     * @param _pStart Position of context before packing of container
+     * @param _size Number of elements
+     * @param _iterator Iterator of container passed to _putNext
+     * @param _putNext Function that packs element at _iterator and advances _iterator
+     * @return Return true if packing is succeed, false otherwise
+     */
+    static BUFFERS_NOINLINE bool putElementsShared(Context & _ctx, uint8_t * _pStart, const size_t _size,
+                                                   void * _iterator, bool (*_putNext)(Context &, void *)) {
+      bool result = true;
+      for (size_t i = 0; result && i < _size; ++i) {
+        result = _putNext(_ctx, _iterator);
+      }
+      if (!result) {
+        _ctx -= static_cast<size_t>(_ctx.buffer() - _pStart);
+      }
+      return result;
+    }
+#else
+    template <typename TBufferContext, typename TContainer, typename TPutElement>
+    static bool putElements(TBufferContext & _ctx, uint8_t * _pStart,
+                            const TContainer & _container, TPutElement _putElement) {
+      bool result = true;
+      for (auto it = _container.begin(); result && it != _container.end(); ++it) {
+        result = _putElement(_ctx, *it);
+      }
+      if (!result) {
+        _ctx -= static_cast<size_t>(_ctx.buffer() - _pStart);
+      }
+      return result;
+    }
+#endif
+
+    /**
+     * Method for packing null-terminated string, shared by char* and std::string
+     * @param _ctx Context of buffer
+     * @param _str String for packing
+     * @param _size Size of string with terminating null character
+     * @return Return true if packing is succeed, false otherwise
+     */
+    static BUFFERS_COMPACT_NOINLINE bool putString(Context & _ctx, const char * _str, const size_t _size) {
+      if (_ctx.getAlignedSize(_size) > _ctx.buffer_size()) {
+        return false;
+      }
+      const uint8_t * pStr = reinterpret_cast<const uint8_t *>(_str);
+      std::copy(pStr, pStr + _size, _ctx.buffer());
+      _ctx += _size;
+      return true;
+    }
   };
 
   inline
@@ -249,7 +834,7 @@ namespace buffers {
     template <typename TBufferContext>
     static bool put(TBufferContext & _ctx, const T & t) {
       bool result = false;
-      if (getTypeSize() <= _ctx.buffer_size()) {
+      if (_ctx.align(alignof(T), getTypeSize())) {
         const uint8_t *p_start_ = reinterpret_cast<const uint8_t *>(&t);
         std::copy(p_start_, p_start_ + sizeof(T), _ctx.buffer());
         _ctx += sizeof(T);
@@ -266,15 +851,7 @@ namespace buffers {
      */
     template <typename TBufferContext, size_t dataLen>
     static bool put(TBufferContext & _ctx, const T (&_buffer)[dataLen]) {
-      bool result = false;
-      if (getTypeSize(_buffer) <= _ctx.size()) {
-        DelegatePackBuffer<decltype(dataLen)>{}.put(_ctx, dataLen);
-        const uint8_t *p_start_ = reinterpret_cast<const uint8_t *>(_buffer);
-        std::copy(p_start_, p_start_ + sizeof(T) * dataLen, _ctx.data());
-        _ctx += sizeof(T) * dataLen;
-        result = true;
-      }
-      return result;
+      return put(_ctx, static_cast<const T *>(_buffer), dataLen);
     }
 
     /**
@@ -288,11 +865,38 @@ namespace buffers {
     static bool put(TBufferContext & _ctx, const T * _buffer, const size_t _dataLen) {
       bool result = false;
       if (_buffer && getTypeSize(_buffer, _dataLen) <= _ctx.buffer_size()) {
-        DelegatePackBuffer<decltype(_dataLen)>{}.put(_ctx, _dataLen);
-        const uint8_t *p_start_ = reinterpret_cast<const uint8_t *>(_buffer);
-        std::copy(p_start_, p_start_ + sizeof(T) * _dataLen, _ctx.buffer());
-        _ctx += sizeof(T) * _dataLen;
-        result = true;
+        uint8_t * const pStart = _ctx.buffer();
+        if (putArrayCount(_ctx, _dataLen, sizeof(T) * _dataLen) && _ctx.align(alignof(T), sizeof(T) * _dataLen)) {
+          const uint8_t *p_start_ = reinterpret_cast<const uint8_t *>(_buffer);
+          CopyEngine::copy(_ctx.buffer(), p_start_, sizeof(T) * _dataLen);
+          _ctx += sizeof(T) * _dataLen;
+          result = true;
+        } else {
+          _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+        }
+      }
+      return result;
+    }
+
+    /**
+     * Method for packing in buffer elements placed at equal distance
+     * @param _base Pointer on first element of packing data
+     * @param _count Number of elements
+     * @param _stride Distance between elements in bytes
+     * @return Return true if packing is succeed, false otherwise
+     */
+    template <typename TBufferContext>
+    static bool putStrided(TBufferContext & _ctx, const T * _base, const size_t _count, const size_t _stride) {
+      bool result = false;
+      if (_base && getTypeSize(_base, _count) <= _ctx.buffer_size()) {
+        uint8_t * const pStart = _ctx.buffer();
+        if (putArrayCount(_ctx, _count, sizeof(T) * _count) && _ctx.align(alignof(T), sizeof(T) * _count)) {
+          CopyEngine::gather(_ctx.buffer(), reinterpret_cast<const uint8_t *>(_base), _count, _stride, sizeof(T));
+          _ctx += sizeof(T) * _count;
+          result = true;
+        } else {
+          _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+        }
       }
       return result;
     }
@@ -307,7 +911,7 @@ namespace buffers {
 
     template< size_t dataLen >
     static size_t getTypeSize(const T (&_buffer)[dataLen]) {
-      return sizeof(_buffer);
+      return (sizeof(size_t) + sizeof(_buffer));
     }
 
     static size_t getTypeSize(const T * _buffer, const size_t dataLen) {
@@ -328,17 +932,7 @@ namespace buffers {
      */
     template <typename TBufferContext>
     static bool put(TBufferContext & _ctx, const char *str) {
-      bool result = false;
-      if (str) {
-        int kCStringLen = getTypeSize(str);
-        if (kCStringLen <= _ctx.buffer_size()) {
-          const uint8_t *p_start_ = reinterpret_cast<const uint8_t *>(str);
-          std::copy(p_start_, p_start_ + kCStringLen, _ctx.buffer());
-          _ctx += kCStringLen;
-          result = true;
-        }
-      }
-      return result;
+      return str != nullptr && putString(_ctx, str, getTypeSize(str));
     }
 
     static size_t getTypeSize(const char *str) {
@@ -346,6 +940,26 @@ namespace buffers {
     }
   };
 
+  template <typename TBufferContext>
+  bool PackBuffer::putArrayCount(TBufferContext & _ctx, const size_t _count, const size_t _size) {
+    if (!_ctx.isArrayAligned(_size)) {
+      return DelegatePackBuffer<size_t>{}.put(_ctx, _count);
+    }
+    if (!DelegatePackBuffer<size_t>{}.put(_ctx, _count | kArrayPaddingFlag)) {
+      return false;
+    }
+    const size_t kBoundary = _ctx.arrayBoundary();
+    const size_t kPaddingStart = getAlignedOffset(_ctx.offset(), alignof(size_t), _ctx.alignment()) +
+                                 buffers::getAlignedSize(sizeof(size_t), _ctx.alignment());
+    const size_t kPadding = (kBoundary - kPaddingStart % kBoundary) % kBoundary;
+    if (!DelegatePackBuffer<size_t>{}.put(_ctx, kPadding) || kPadding + _size > _ctx.buffer_size()) {
+      return false;
+    }
+    std::fill(_ctx.buffer(), _ctx.buffer() + kPadding, 0);
+    _ctx += kPadding;
+    return true;
+  }
+
   template <size_t dataLen>
   bool PackBuffer::put(const char (&_buffer)[dataLen]) {
     auto packer = DelegatePackBuffer<char *>{};
@@ -354,6 +968,11 @@ namespace buffers {
     return result;
   }
 
+  template <size_t dataLen>
+  size_t PackBuffer::getTypeSize(const char (&_str)[dataLen]) {
+    return DelegatePackBuffer<char *>{}.getTypeSize(_str);
+  }
+
   /**
    * Specialization DelegatePackBuffer class for std::string
    */
@@ -367,15 +986,7 @@ namespace buffers {
      */
     template <typename TBufferContext>
     static bool put(TBufferContext & _ctx, const std::string & _str) {
-      bool result = false;
-      const int kCStringLen = getTypeSize(_str);
-      if (kCStringLen <= _ctx.buffer_size()) {
-        const uint8_t *p_start_ = reinterpret_cast<const uint8_t *>(_str.c_str());
-        std::copy(p_start_, p_start_ + kCStringLen, _ctx.buffer());
-        _ctx += kCStringLen;
-        result = true;
-      }
-      return result;
+      return putString(_ctx, _str.c_str(), getTypeSize(_str));
     }
 
     static size_t getTypeSize(const std::string & _str) {
@@ -400,12 +1011,7 @@ namespace buffers {
     static bool put(TBufferContext & _ctx, const std::vector<T> & _vec) {
       bool result = false;
       if (_vec.size() > 0) {
-        if (getTypeSize(_vec) <= _ctx.buffer_size()) {
-          DelegatePackBuffer<decltype(_vec.size())>{}.put(_ctx, _vec.size());
-          std::copy(_vec.data(), _vec.data() + _vec.size(), (T*)(_ctx.buffer()));
-          _ctx += _vec.size() * sizeof(T);
-          result = true;
-        }
+        result = putVector(_ctx, _vec);
       }
       return result;
     }
@@ -426,6 +1032,47 @@ namespace buffers {
       }
       return typeSize;
     }
+
+   private:
+    /**
+     * Elements of trivial type are packed as one continuous block,
+     * so they are packed with one bulk copy
+     */
+    template <typename TBufferContext, typename TT>
+    static typename std::enable_if<(std::is_trivial<TT>::value), bool>::type
+    putVector(TBufferContext & _ctx, const std::vector<TT> & _vec) {
+      bool result = false;
+      if (getTypeSize(_vec) <= _ctx.buffer_size()) {
+        uint8_t * const pStart = _ctx.buffer();
+        if (putArrayCount(_ctx, _vec.size(), _vec.size() * sizeof(TT)) &&
+            _ctx.align(alignof(TT), _vec.size() * sizeof(TT))) {
+          CopyEngine::copy(_ctx.buffer(), reinterpret_cast<const uint8_t *>(_vec.data()), _vec.size() * sizeof(TT));
+          _ctx += _vec.size() * sizeof(TT);
+          result = true;
+        } else {
+          _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+        }
+      }
+      return result;
+    }
+
+    /**
+     * Elements of non-trivial type are packed one by one, as they are unpacked.
+     * Size of packed elements is known only after packing, for example repeated
+     * shared objects are packed as back-references, so it is not checked in advance
+     */
+    template <typename TBufferContext, typename TT>
+    static typename std::enable_if<!(std::is_trivial<TT>::value), bool>::type
+    putVector(TBufferContext & _ctx, const std::vector<TT> & _vec) {
+      bool result = false;
+      uint8_t * pStart = _ctx.buffer();
+      if (DelegatePackBuffer<typename std::vector<TT>::size_type>{}.put(_ctx, _vec.size())) {
+        result = putElements(_ctx, pStart, _vec, [](TBufferContext & _elemCtx, const TT & _ve) {
+          return DelegatePackBuffer<TT>{}.put(_elemCtx, _ve);
+        });
+      }
+      return result;
+    }
   };
 
   /**
@@ -445,12 +1092,11 @@ namespace buffers {
     static bool put(TBufferContext & _ctx, const std::list<T> & _lst) {
       bool result = false;
       if (_lst.size() > 0) {
-        if (getTypeSize(_lst) <= _ctx.buffer_size()) {
-          DelegatePackBuffer<decltype(_lst.size())>{}.put(_ctx, _lst.size());
-          for (auto ve : _lst) {
-            DelegatePackBuffer<T>{}.put(_ctx, ve);
-          }
-          result = true;
+        uint8_t * pStart = _ctx.buffer();
+        if (DelegatePackBuffer<decltype(_lst.size())>{}.put(_ctx, _lst.size())) {
+          result = putElements(_ctx, pStart, _lst, [](TBufferContext & _elemCtx, const T & _ve) {
+            return DelegatePackBuffer<T>{}.put(_elemCtx, _ve);
+          });
         }
       }
       return result;
@@ -490,12 +1136,11 @@ namespace buffers {
     static bool put(TBufferContext & _ctx, const std::set<K> & _set) {
       bool result = false;
       if (_set.size() > 0) {
-        if (getTypeSize(_set) <= _ctx.buffer_size()) {
-          DelegatePackBuffer<decltype(_set.size())>{}.put(_ctx, _set.size());
-          for (auto& ve : _set) {
-            DelegatePackBuffer<K>{}.put(_ctx, ve);
-          }
-          result = true;
+        uint8_t * pStart = _ctx.buffer();
+        if (DelegatePackBuffer<decltype(_set.size())>{}.put(_ctx, _set.size())) {
+          result = putElements(_ctx, pStart, _set, [](TBufferContext & _elemCtx, const K & _ve) {
+            return DelegatePackBuffer<K>{}.put(_elemCtx, _ve);
+          });
         }
       }
       return result;
@@ -568,13 +1213,12 @@ namespace buffers {
     static bool put(TBufferContext & _ctx, const std::map<K, V> & _mp) {
       bool result = false;
       if (_mp.size() > 0) {
-        if (getTypeSize(_mp) <= _ctx.buffer_size()) {
-          DelegatePackBuffer<decltype(_mp.size())>{}.put(_ctx, _mp.size());
-          for (auto& ve : _mp) {
-            DelegatePackBuffer<K>{}.put(_ctx, ve.first);
-            DelegatePackBuffer<V>{}.put(_ctx, ve.second);
-          }
-          result = true;
+        uint8_t * pStart = _ctx.buffer();
+        if (DelegatePackBuffer<decltype(_mp.size())>{}.put(_ctx, _mp.size())) {
+          result = putElements(_ctx, pStart, _mp, [](TBufferContext & _elemCtx, const std::pair<const K, V> & _ve) {
+            return DelegatePackBuffer<K>{}.put(_elemCtx, _ve.first) &&
+                   DelegatePackBuffer<V>{}.put(_elemCtx, _ve.second);
+          });
         }
       }
       return result;
@@ -582,7 +1226,7 @@ namespace buffers {
 
     template <typename KK, typename VV>
     static typename std::enable_if<(std::is_trivial<KK>::value && std::is_trivial<VV>::value), size_t>::type
-    getTypeSize(const std::unordered_map<KK, VV> & _mp) {
+    getTypeSize(const std::map<KK, VV> & _mp) {
       return (sizeof(_mp.size()) + (sizeof(KK) + sizeof(VV)) * _mp.size());
     }
 
@@ -615,12 +1259,18 @@ namespace buffers {
     static bool put(TBufferContext & _ctx, const std::unordered_set<K> & _set) {
       bool result = false;
       if (_set.size() > 0) {
-        if (getTypeSize(_set) <= _ctx.buffer_size()) {
-          DelegatePackBuffer<decltype(_set.size())>{}.put(_ctx, _set.size());
-          for (auto& ve : _set) {
-            DelegatePackBuffer<K>{}.put(_ctx, ve);
+        uint8_t * pStart = _ctx.buffer();
+        if (DelegatePackBuffer<decltype(_set.size())>{}.put(_ctx, _set.size())) {
+          auto putElement = [](TBufferContext & _elemCtx, const K & _ve) {
+            return DelegatePackBuffer<K>{}.put(_elemCtx, _ve);
+          };
+          if (_ctx.isCanonical()) {
+            result = putSortedElements(_ctx, pStart, _set, [](const K & _ve) -> const K & {
+              return _ve;
+            }, putElement);
+          } else {
+            result = putElements(_ctx, pStart, _set, putElement);
           }
-          result = true;
         }
       }
       return result;
@@ -662,13 +1312,19 @@ namespace buffers {
     static bool put(TBufferContext & _ctx, const std::unordered_map<K, V> & _mp) {
       bool result = false;
       if (_mp.size() > 0) {
-        if (getTypeSize(_mp) <= _ctx.buffer_size()) {
-          DelegatePackBuffer<decltype(_mp.size())>{}.put(_ctx, _mp.size());
-          for (auto& ve : _mp) {
-            DelegatePackBuffer<K>{}.put(_ctx, ve.first);
-            DelegatePackBuffer<V>{}.put(_ctx, ve.second);
+        uint8_t * pStart = _ctx.buffer();
+        if (DelegatePackBuffer<decltype(_mp.size())>{}.put(_ctx, _mp.size())) {
+          auto putElement = [](TBufferContext & _elemCtx, const std::pair<const K, V> & _ve) {
+            return DelegatePackBuffer<K>{}.put(_elemCtx, _ve.first) &&
+                   DelegatePackBuffer<V>{}.put(_elemCtx, _ve.second);
+          };
+          if (_ctx.isCanonical()) {
+            result = putSortedElements(_ctx, pStart, _mp, [](const std::pair<const K, V> & _ve) -> const K & {
+              return _ve.first;
+            }, putElement);
+          } else {
+            result = putElements(_ctx, pStart, _mp, putElement);
           }
-          result = true;
         }
       }
       return result;
@@ -692,6 +1348,84 @@ namespace buffers {
     }
   };
 
+  /**
+   * Specialization DelegatePackBuffer class for std::shared_ptr.
+   * Every shared object is packed once per message, repeated pointers
+   * to the same object of the same type are packed as back-reference by id:
+   *     0 - null pointer,
+   *     id of the next new object - new object, followed by packed object,
+   *     smaller id - back-reference to object packed earlier.
+   * Registry of packed objects is cleared by PackBuffer::reset()
+   * @tparam T Type of shared object
+   */
+  template <typename T>
+  class PackBuffer::DelegatePackBuffer<std::shared_ptr<T>> {
+   public:
+    template <typename TBufferContext>
+    static bool put(TBufferContext & _ctx, const std::shared_ptr<T> & _ptr) {
+      if (!_ptr) {
+        return DelegatePackBuffer<size_t>{}.put(_ctx, size_t{0});
+      }
+      const size_t kSharedId = _ctx.sharedId(_ptr.get(), getTypeTag<T>());
+      if (kSharedId != 0) {
+        return DelegatePackBuffer<size_t>{}.put(_ctx, kSharedId);
+      }
+      uint8_t * pStart = _ctx.buffer();
+      const size_t kNewId = _ctx.addShared(_ptr.get(), getTypeTag<T>());
+      if (!DelegatePackBuffer<size_t>{}.put(_ctx, kNewId)) {
+        _ctx.removeShared(kNewId);
+        return false;
+      }
+      if (!DelegatePackBuffer<T>{}.put(_ctx, *_ptr)) {
+        _ctx.removeShared(kNewId);
+        _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+        return false;
+      }
+      return true;
+    }
+
+    static size_t getTypeSize(const std::shared_ptr<T> & _ptr) {
+      return sizeof(size_t) + (_ptr ? DelegatePackBuffer<T>{}.getTypeSize(*_ptr) : 0);
+    }
+  };
+
+  /**
+   * Specialization DelegatePackBuffer class for std::unique_ptr.
+   * Packed as presence flag followed by packed object if pointer is not null
+   * @tparam T Type of owned object
+   */
+  template <typename T>
+  class PackBuffer::DelegatePackBuffer<std::unique_ptr<T>> {
+   public:
+    template <typename TBufferContext>
+    static bool put(TBufferContext & _ctx, const std::unique_ptr<T> & _ptr) {
+      uint8_t * pStart = _ctx.buffer();
+      if (!DelegatePackBuffer<uint8_t>{}.put(_ctx, static_cast<uint8_t>(_ptr ? 1 : 0))) {
+        return false;
+      }
+      if (_ptr && !DelegatePackBuffer<T>{}.put(_ctx, *_ptr)) {
+        _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+        return false;
+      }
+      return true;
+    }
+
+    static size_t getTypeSize(const std::unique_ptr<T> & _ptr) {
+      return sizeof(uint8_t) + (_ptr ? DelegatePackBuffer<T>{}.getTypeSize(*_ptr) : 0);
+    }
+  };
+
+  /**
+   * Method for comparing packed messages without unpacking.
+   * Padding is always zeroed, so equal values packed with the same alignment are equal byte by byte
+   * @return true if messages are packed to the same bytes, false otherwise
+   */
+  inline bool isEqualPacked(const PackBuffer & _lhs, const PackBuffer & _rhs) {
+    return _lhs.getAlignment() == _rhs.getAlignment() &&
+           _lhs.getDataSize() == _rhs.getDataSize() &&
+           std::memcmp(_lhs.getData(), _rhs.getData(), _lhs.getDataSize()) == 0;
+  }
+
   template <typename T>
   PackBuffer& operator<<(PackBuffer& buffer, T && t) {
     buffer.put(std::forward<T>(t));
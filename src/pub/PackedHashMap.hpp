@@ -0,0 +1,389 @@
+/**
+ * @file PackedHashMap.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains packing of std::unordered_map with minimal perfect hash index
+ *        and view for O(1) lookups over packed bytes
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_PACKEDHASHMAP_HPP
+#define BUFFERS_PACKEDHASHMAP_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+#include "AlignMemory.hpp"
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Helper functions for building and querying minimal perfect hash index.
+   * Index is built with hash-and-displace scheme: keys are split into buckets,
+   * for every bucket is found displacement that puts all its keys in free slots
+   */
+  class PerfectHashIndex {
+   public:
+    /**
+     * Average number of keys in one bucket of index
+     */
+    static constexpr size_t kBucketLoad = 4;
+
+    /**
+     * Minimum number of displacements tried for one bucket before build fails
+     */
+    static constexpr uint64_t kMinDisplacements = 4096;
+
+    /**
+     * Number of displacements per key tried for one bucket before build fails
+     */
+    static constexpr uint64_t kDisplacementsPerKey = 16;
+
+    static uint64_t hashKey(const char * _key, const size_t _len) {
+      uint64_t hash = 14695981039346656037ULL;
+      for (size_t i = 0; i < _len; ++i) {
+        hash ^= static_cast<uint8_t>(_key[i]);
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    static size_t getNumBuckets(const size_t _numKeys) {
+      return _numKeys / kBucketLoad + 1;
+    }
+
+    static size_t getBucket(const uint64_t _hash, const size_t _numBuckets) {
+      return mix(_hash) % _numBuckets;
+    }
+
+    static size_t getSlot(const uint64_t _hash, const uint32_t _displacement, const size_t _numSlots) {
+      return mix(_hash + (static_cast<uint64_t>(_displacement) + 1) * 0x9E3779B97F4A7C15ULL) % _numSlots;
+    }
+
+    /**
+     * Method for building displacements of index.
+     * Keys with equal hashes can not be separated by any displacement, so build fails for them at once.
+     * Search of displacement for one bucket is limited by max(kMinDisplacements, kDisplacementsPerKey * number of keys),
+     * which is enough for the last single-key buckets placed in almost full index
+     * @param _hashes Hashes of keys
+     * @param _displacements Displacement for every bucket
+     * @param _slots Index of key for every slot
+     * @return true if index is built, false otherwise
+     */
+    static bool build(const std::vector<uint64_t> & _hashes,
+                      std::vector<uint32_t> & _displacements,
+                      std::vector<size_t> & _slots) {
+      const size_t kNumKeys = _hashes.size();
+      const size_t kNumBuckets = getNumBuckets(kNumKeys);
+      std::vector<std::vector<size_t>> buckets(kNumBuckets);
+      for (size_t i = 0; i < kNumKeys; ++i) {
+        buckets[getBucket(_hashes[i], kNumBuckets)].push_back(i);
+      }
+      std::vector<size_t> order(kNumBuckets);
+      for (size_t i = 0; i < kNumBuckets; ++i) {
+        order[i] = i;
+      }
+      std::stable_sort(order.begin(), order.end(), [&buckets](size_t _lhs, size_t _rhs) {
+        return buckets[_lhs].size() > buckets[_rhs].size();
+      });
+
+      const size_t kEmptySlot = std::numeric_limits<size_t>::max();
+      _displacements.assign(kNumBuckets, 0);
+      _slots.assign(kNumKeys, kEmptySlot);
+      const uint64_t kMaxDisplacements = std::min(std::max(uint64_t{kMinDisplacements}, kDisplacementsPerKey * kNumKeys),
+                                                  uint64_t{std::numeric_limits<uint32_t>::max()});
+      std::vector<size_t> bucketSlots;
+      for (auto bucketIdx : order) {
+        const auto & kBucket = buckets[bucketIdx];
+        if (kBucket.empty()) {
+          break;
+        }
+        for (size_t i = 0; i < kBucket.size(); ++i) {
+          for (size_t j = i + 1; j < kBucket.size(); ++j) {
+            if (_hashes[kBucket[i]] == _hashes[kBucket[j]]) {
+              return false;
+            }
+          }
+        }
+        bool isPlaced = false;
+        for (uint64_t displacement = 0; !isPlaced && displacement < kMaxDisplacements; ++displacement) {
+          bucketSlots.clear();
+          isPlaced = true;
+          for (auto keyIdx : kBucket) {
+            const size_t kSlot = getSlot(_hashes[keyIdx], static_cast<uint32_t>(displacement), kNumKeys);
+            if (_slots[kSlot] != kEmptySlot ||
+                std::find(bucketSlots.begin(), bucketSlots.end(), kSlot) != bucketSlots.end()) {
+              isPlaced = false;
+              break;
+            }
+            bucketSlots.push_back(kSlot);
+          }
+          if (isPlaced) {
+            for (size_t i = 0; i < kBucket.size(); ++i) {
+              _slots[bucketSlots[i]] = kBucket[i];
+            }
+            _displacements[bucketIdx] = static_cast<uint32_t>(displacement);
+          }
+        }
+        if (!isPlaced) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+   private:
+    static uint64_t mix(uint64_t _value) {
+      _value ^= _value >> 33;
+      _value *= 0xff51afd7ed558ccdULL;
+      _value ^= _value >> 33;
+      _value *= 0xc4ceb9fe1a85ec53ULL;
+      _value ^= _value >> 33;
+      return _value;
+    }
+  };
+
+  /**
+   * Wrapper that requests packing of std::unordered_map together with
+   * minimal perfect hash index. Packed layout is:
+   *     number of entries, size of entries, entries (key, value),
+   *     displacements of buckets, offsets of entries for every slot
+   * @tparam V Type of value of std::unordered_map
+   */
+  template <typename V>
+  class HashIndexedMap {
+   public:
+    explicit HashIndexedMap(const std::unordered_map<std::string, V> & _map)
+        : map_(_map) {
+    }
+
+    const std::unordered_map<std::string, V> & map() const {
+      return map_;
+    }
+
+   private:
+    const std::unordered_map<std::string, V> & map_;
+  };
+
+  /**
+   * Method for creating wrapper that packs std::unordered_map with hash index
+   * @param _map std::unordered_map for packing
+   * @return Wrapper for packing
+   */
+  template <typename V>
+  HashIndexedMap<V> withHashIndex(const std::unordered_map<std::string, V> & _map) {
+    return HashIndexedMap<V>(_map);
+  }
+
+  /**
+   * View over std::unordered_map packed with minimal perfect hash index.
+   * Allows O(1) lookups directly on packed bytes
+   * @tparam V Type of value of std::unordered_map
+   */
+  template <typename V>
+  class PackedHashMapView {
+   public:
+    PackedHashMapView()
+        : p_entries_{nullptr}
+        , entries_size_{0}
+        , size_{0}
+        , p_displacements_{nullptr}
+        , num_buckets_{0}
+        , p_offsets_{nullptr}
+        , alignment_{static_cast<AlignMemory>(sizeof(int))}
+        , entries_origin_{0} {
+    }
+
+    PackedHashMapView(uint8_t const * _pEntries, const size_t _entriesSize, const size_t _size,
+                      uint8_t const * _pDisplacements, const size_t _numBuckets,
+                      uint8_t const * _pOffsets, AlignMemory _alignment,
+                      const size_t _entriesOrigin = 0)
+        : p_entries_{_pEntries}
+        , entries_size_{_entriesSize}
+        , size_{_size}
+        , p_displacements_{_pDisplacements}
+        , num_buckets_{_numBuckets}
+        , p_offsets_{_pOffsets}
+        , alignment_{_alignment}
+        , entries_origin_{_entriesOrigin} {
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    /**
+     * Method for checking if view contains key
+     * @param _key Key for searching
+     * @return true if key is found, false otherwise
+     */
+    bool contains(const std::string & _key) const {
+      return findEntry(_key) != nullptr;
+    }
+
+    /**
+     * Method for finding value by key
+     * @param _key Key for searching
+     * @param _value Found value
+     * @return true if value is found, false otherwise
+     */
+    bool find(const std::string & _key, V & _value) const {
+      uint8_t const * pEntry = findEntry(_key);
+      if (pEntry) {
+        uint8_t const * pValue = pEntry + getAlignedSize(_key.size() + 1, alignment_);
+        UnpackBuffer unbuffer(pValue, static_cast<size_t>(p_entries_ + entries_size_ - pValue), alignment_,
+                              entries_origin_ + static_cast<size_t>(pValue - p_entries_));
+        _value = unbuffer.get<V>();
+        return true;
+      }
+      return false;
+    }
+
+   private:
+    uint8_t const * findEntry(const std::string & _key) const {
+      if (size_ == 0) {
+        return nullptr;
+      }
+      const uint64_t kHash = PerfectHashIndex::hashKey(_key.data(), _key.size());
+      uint32_t displacement;
+      std::memcpy(&displacement,
+                  p_displacements_ + PerfectHashIndex::getBucket(kHash, num_buckets_) * sizeof(uint32_t),
+                  sizeof(uint32_t));
+      size_t offset;
+      std::memcpy(&offset,
+                  p_offsets_ + PerfectHashIndex::getSlot(kHash, displacement, size_) * sizeof(size_t),
+                  sizeof(size_t));
+      uint8_t const * pEntry = p_entries_ + offset;
+      if (offset + _key.size() < entries_size_ &&
+          std::memcmp(pEntry, _key.c_str(), _key.size() + 1) == 0) {
+        return pEntry;
+      }
+      return nullptr;
+    }
+
+    uint8_t const * p_entries_;
+    size_t entries_size_;
+    size_t size_;
+    uint8_t const * p_displacements_;
+    size_t num_buckets_;
+    uint8_t const * p_offsets_;
+    AlignMemory alignment_;
+    size_t entries_origin_;
+  };
+
+  /**
+   * Specialization DelegatePackBuffer class for std::unordered_map with hash index
+   * @tparam V Value of std::unordered_map
+   */
+  template <typename V>
+  class PackBuffer::DelegatePackBuffer<HashIndexedMap<V>> {
+   public:
+    /**
+     * Method for packing std::unordered_map with hash index in buffer
+     * @param _indexed Wrapper of std::unordered_map for packing
+     * @return Return true if packing is succeed, false otherwise
+     */
+    template <typename TBufferContext>
+    static bool put(TBufferContext & _ctx, const HashIndexedMap<V> & _indexed) {
+      const auto & kMap = _indexed.map();
+      // Size without padding is only lower bound, every field checks its aligned size
+      if (kMap.empty() || getTypeSize(_indexed) > _ctx.buffer_size()) {
+        return false;
+      }
+
+      std::vector<uint64_t> hashes;
+      hashes.reserve(kMap.size());
+      for (auto & ve : kMap) {
+        hashes.push_back(PerfectHashIndex::hashKey(ve.first.data(), ve.first.size()));
+      }
+      std::vector<uint32_t> displacements;
+      std::vector<size_t> slots;
+      if (!PerfectHashIndex::build(hashes, displacements, slots)) {
+        return false;
+      }
+
+      uint8_t * const pStart = _ctx.buffer();
+      if (!DelegatePackBuffer<size_t>{}.put(_ctx, kMap.size())) {
+        return false;
+      }
+      uint8_t * pEntriesSize = _ctx.buffer();
+      if (!DelegatePackBuffer<size_t>{}.put(_ctx, size_t{0})) {
+        _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+        return false;
+      }
+      uint8_t * pEntries = _ctx.buffer();
+      std::vector<size_t> entryOffsets;
+      entryOffsets.reserve(kMap.size());
+      for (auto & ve : kMap) {
+        entryOffsets.push_back(static_cast<size_t>(_ctx.buffer() - pEntries));
+        if (!DelegatePackBuffer<std::string>{}.put(_ctx, ve.first) ||
+            !DelegatePackBuffer<V>{}.put(_ctx, ve.second)) {
+          _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+          return false;
+        }
+      }
+      const size_t kEntriesSize = static_cast<size_t>(_ctx.buffer() - pEntries);
+      _ctx.patch(pEntriesSize, &kEntriesSize, sizeof(kEntriesSize));
+
+      std::vector<size_t> slotOffsets(slots.size());
+      for (size_t i = 0; i < slots.size(); ++i) {
+        slotOffsets[i] = entryOffsets[slots[i]];
+      }
+      if (!DelegatePackBuffer<uint32_t>{}.put(_ctx, displacements.data(), displacements.size()) ||
+          !DelegatePackBuffer<size_t>{}.put(_ctx, slotOffsets.data(), slotOffsets.size())) {
+        _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+        return false;
+      }
+      return true;
+    }
+
+    static size_t getTypeSize(const HashIndexedMap<V> & _indexed) {
+      const auto & kMap = _indexed.map();
+      const size_t kNumBuckets = PerfectHashIndex::getNumBuckets(kMap.size());
+      return sizeof(size_t) +
+             DelegatePackBuffer<std::unordered_map<std::string, V>>{}.getTypeSize(kMap) +
+             sizeof(size_t) + sizeof(uint32_t) * kNumBuckets +
+             sizeof(size_t) + sizeof(size_t) * kMap.size();
+    }
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for PackedHashMapView.
+   * Does not decode entries, only moves context after the packed std::unordered_map
+   */
+  template<typename V>
+  class UnpackBuffer::DelegateUnpackBuffer<PackedHashMapView<V>> {
+   public:
+    template <typename TBufferContext>
+    static PackedHashMapView<V> get(TBufferContext & _ctx) {
+      const auto kSize = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      const auto kEntriesSize = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      uint8_t const * pEntries = _ctx.buffer();
+      const size_t kEntriesOrigin = _ctx.offset();
+      _ctx += kEntriesSize;
+      const auto kNumBuckets = getArrayCount(_ctx);
+      _ctx.align(alignof(uint32_t));
+      uint8_t const * pDisplacements = _ctx.buffer();
+      _ctx += kNumBuckets * sizeof(uint32_t);
+      const auto kNumSlots = getArrayCount(_ctx);
+      _ctx.align(alignof(size_t));
+      uint8_t const * pOffsets = _ctx.buffer();
+      _ctx += kNumSlots * sizeof(size_t);
+      return PackedHashMapView<V>(pEntries, kEntriesSize, kSize,
+                                  pDisplacements, kNumBuckets,
+                                  pOffsets, _ctx.alignment(), kEntriesOrigin);
+    }
+  };
+}
+
+#endif //BUFFERS_PACKEDHASHMAP_HPP
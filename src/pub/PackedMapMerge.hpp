@@ -0,0 +1,111 @@
+/**
+ * @file PackedMapMerge.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains streaming k-way merge of packed sorted maps
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_PACKEDMAPMERGE_HPP
+#define BUFFERS_PACKEDMAPMERGE_HPP
+
+#include <stdint.h>
+#include <map>
+#include <queue>
+#include <vector>
+#include <utility>
+
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Method for merging of several packed std::map<K, V> into one packed std::map<K, V>.
+   * Every input should be positioned at the beginning of packed std::map.
+   * Only keys are decoded, values are copied verbatim from inputs to output,
+   * so memory usage is O(number of inputs).
+   * If the same key is present in several inputs, value from the last input wins.
+   * Inputs and output should use the same alignment. Natural alignment is not
+   * supported, because padding inside of copied values depends on their position.
+   * If merging fails output is rolled back to its data size before merging,
+   * inputs are left partially read
+   * @tparam K Key of std::map
+   * @tparam V Value of std::map
+   * @param _out Buffer where merged std::map is packed
+   * @param _inputs Buffers with packed std::map for merging
+   * @return Return true if merging is succeed, false otherwise
+   */
+  template <typename K, typename V>
+  bool mergePackedMaps(PackBuffer & _out, const std::vector<UnpackBuffer *> & _inputs) {
+    if (_out.getAlignment() == AlignMemory::Natural) {
+      return false;
+    }
+    for (auto input : _inputs) {
+      if (input->getAlignment() != _out.getAlignment()) {
+        return false;
+      }
+    }
+
+    const size_t kStart = _out.getDataSize();
+    auto sizeField = _out.putField<typename std::map<K, V>::size_type>(0);
+    if (!sizeField.isValid()) {
+      return false;
+    }
+
+    // Smallest key on top, for equal keys the last input on top
+    typedef std::pair<K, size_t> HeadEntry;
+    auto headCompare = [](const HeadEntry & _lhs, const HeadEntry & _rhs) {
+      if (_rhs.first < _lhs.first) {
+        return true;
+      }
+      if (_lhs.first < _rhs.first) {
+        return false;
+      }
+      return _lhs.second < _rhs.second;
+    };
+    std::priority_queue<HeadEntry, std::vector<HeadEntry>, decltype(headCompare)> heads(headCompare);
+    std::vector<size_t> leftEntries(_inputs.size());
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+      leftEntries[i] = _inputs[i]->template get<typename std::map<K, V>::size_type>();
+      if (leftEntries[i] > 0) {
+        heads.push(HeadEntry(_inputs[i]->template get<K>(), i));
+      }
+    }
+
+    auto moveToNextEntry = [&](const size_t _idx) {
+      if (--leftEntries[_idx] > 0) {
+        heads.push(HeadEntry(_inputs[_idx]->template get<K>(), _idx));
+      }
+    };
+
+    typename std::map<K, V>::size_type numMerged = 0;
+    while (!heads.empty()) {
+      const HeadEntry kHead = heads.top();
+      heads.pop();
+      UnpackBuffer & input = *_inputs[kHead.second];
+      uint8_t const * pValue = input.getCurrentData();
+      input.template skip<V>();
+      if (!_out.put(kHead.first) ||
+          !_out.putRaw(pValue, static_cast<size_t>(input.getCurrentData() - pValue))) {
+        _out.rollback(kStart);
+        return false;
+      }
+      ++numMerged;
+      moveToNextEntry(kHead.second);
+
+      while (!heads.empty() && !(kHead.first < heads.top().first)) {
+        const size_t kIdx = heads.top().second;
+        heads.pop();
+        _inputs[kIdx]->template skip<V>();
+        moveToNextEntry(kIdx);
+      }
+    }
+    if (!_out.patch(sizeField, numMerged)) {
+      _out.rollback(kStart);
+      return false;
+    }
+    return true;
+  }
+}
+
+#endif //BUFFERS_PACKEDMAPMERGE_HPP
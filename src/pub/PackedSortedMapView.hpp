@@ -0,0 +1,356 @@
+/**
+ * @file PackedSortedMapView.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains views for searching packed std::map and std::set without decoding
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_PACKEDSORTEDMAPVIEW_HPP
+#define BUFFERS_PACKEDSORTEDMAPVIEW_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#include "AlignMemory.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Base class for views over packed sorted keys of fixed size.
+   * Keys are placed in the buffer one by one with constant stride
+   * @tparam K Type of key. Should be a trivial type
+   */
+  template <typename K>
+  class PackedSortedKeys {
+#if __cplusplus > 199711L
+    static_assert(std::is_trivial<K>::value, "Type K is not a trivial type !!");
+#endif
+
+   public:
+    /**
+     * Number of entries after which binary search switches to linear scan.
+     * Linear scan over small window is branch free and could be vectorized
+     */
+    static constexpr size_t kLinearScanSize = 16;
+
+    /**
+     * Method for getting number of packed entries
+     * @return Number of packed entries
+     */
+    size_t size() const {
+      return size_;
+    }
+
+    /**
+     * Method for checking if view does not contain entries
+     * @return true if view is empty, false otherwise
+     */
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    /**
+     * Method for getting key of entry by index
+     * @param _idx Index of entry
+     * @return Key of entry
+     */
+    K key(const size_t _idx) const {
+      K result;
+      std::memcpy(&result, p_entries_ + _idx * entry_stride_, sizeof(K));
+      return result;
+    }
+
+    /**
+     * Method for getting index of first entry which key is not less than _key
+     * @param _key Key for searching
+     * @return Index of entry or size() if there is no such entry
+     */
+    size_t lowerBoundIndex(const K & _key) const {
+      return boundIndex(_key, [](const K & _lhs, const K & _rhs) { return _lhs < _rhs; });
+    }
+
+    /**
+     * Method for getting index of first entry which key is greater than _key
+     * @param _key Key for searching
+     * @return Index of entry or size() if there is no such entry
+     */
+    size_t upperBoundIndex(const K & _key) const {
+      return boundIndex(_key, [](const K & _lhs, const K & _rhs) { return !(_rhs < _lhs); });
+    }
+
+    /**
+     * Method for getting index of entry with key equal to _key
+     * @param _key Key for searching
+     * @return Index of entry or size() if there is no such entry
+     */
+    size_t findIndex(const K & _key) const {
+      const size_t kIdx = lowerBoundIndex(_key);
+      if (kIdx < size_ && !(_key < key(kIdx))) {
+        return kIdx;
+      }
+      return size_;
+    }
+
+    /**
+     * Method for checking if view contains entry with key equal to _key
+     * @param _key Key for searching
+     * @return true if entry is found, false otherwise
+     */
+    bool contains(const K & _key) const {
+      return findIndex(_key) != size_;
+    }
+
+   protected:
+    PackedSortedKeys()
+        : p_entries_{nullptr}
+        , size_{0}
+        , entry_stride_{0} {
+    }
+
+    PackedSortedKeys(uint8_t const * _pEntries, const size_t _size, const size_t _entryStride)
+        : p_entries_{_pEntries}
+        , size_{_size}
+        , entry_stride_{_entryStride} {
+    }
+
+    template <typename TLess>
+    size_t boundIndex(const K & _key, TLess _less) const {
+      size_t first = 0;
+      size_t len = size_;
+      while (len > kLinearScanSize) {
+        const size_t kHalf = len / 2;
+        first = _less(key(first + kHalf), _key) ? first + kHalf : first;
+        len -= kHalf;
+      }
+      size_t numLess = 0;
+      for (size_t i = 0; i < len; ++i) {
+        numLess += _less(key(first + i), _key) ? 1 : 0;
+      }
+      return first + numLess;
+    }
+
+    uint8_t const * p_entries_;
+    size_t size_;
+    size_t entry_stride_;
+  };
+
+  /**
+   * View over packed std::map with fixed size key and value.
+   * Allows O(log n) lookups and range scans directly on packed bytes
+   * @tparam K Type of key. Should be a trivial type
+   * @tparam V Type of value. Should be a trivial type
+   */
+  template <typename K, typename V>
+  class PackedSortedMapView
+      : public PackedSortedKeys<K> {
+#if __cplusplus > 199711L
+    static_assert(std::is_trivial<V>::value, "Type V is not a trivial type !!");
+#endif
+
+   public:
+    /**
+     * Iterator over entries of the view
+     */
+    class const_iterator {
+     public:
+      const_iterator(const PackedSortedMapView * _view, const size_t _idx)
+          : p_view_{_view}
+          , idx_{_idx} {
+      }
+
+      std::pair<K, V> operator*() const {
+        return std::make_pair(p_view_->key(idx_), p_view_->value(idx_));
+      }
+
+      const_iterator & operator++() {
+        ++idx_;
+        return *this;
+      }
+
+      bool operator==(const const_iterator & _other) const {
+        return idx_ == _other.idx_;
+      }
+
+      bool operator!=(const const_iterator & _other) const {
+        return idx_ != _other.idx_;
+      }
+
+      size_t index() const {
+        return idx_;
+      }
+
+     private:
+      const PackedSortedMapView * p_view_;
+      size_t idx_;
+    };
+
+    PackedSortedMapView() = default;
+
+    /**
+     * Constructor of view over packed entries of std::map
+     * @param _pEntries Pointer to the first packed entry
+     * @param _size Number of packed entries
+     * @param _alignment Alignment with which std::map was packed
+     */
+    PackedSortedMapView(uint8_t const * _pEntries, const size_t _size, AlignMemory _alignment)
+        : PackedSortedKeys<K>(_pEntries, _size, getEntrySize(_alignment))
+        , value_offset_{getValueOffset(_alignment)} {
+    }
+
+    /**
+     * Method for getting value of entry by index
+     * @param _idx Index of entry
+     * @return Value of entry
+     */
+    V value(const size_t _idx) const {
+      V result;
+      std::memcpy(&result, this->p_entries_ + _idx * this->entry_stride_ + value_offset_, sizeof(V));
+      return result;
+    }
+
+    /**
+     * Method for finding value by key
+     * @param _key Key for searching
+     * @param _value Found value
+     * @return true if value is found, false otherwise
+     */
+    bool find(const K & _key, V & _value) const {
+      const size_t kIdx = this->findIndex(_key);
+      if (kIdx != this->size_) {
+        _value = value(kIdx);
+        return true;
+      }
+      return false;
+    }
+
+    const_iterator begin() const {
+      return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+      return const_iterator(this, this->size_);
+    }
+
+    const_iterator lower_bound(const K & _key) const {
+      return const_iterator(this, this->lowerBoundIndex(_key));
+    }
+
+    const_iterator upper_bound(const K & _key) const {
+      return const_iterator(this, this->upperBoundIndex(_key));
+    }
+
+    /**
+     * Method for getting range of entries with keys in [_from, _to)
+     * @param _from First key of range
+     * @param _to Key after the last one in range
+     * @return Pair of iterators to the range
+     */
+    std::pair<const_iterator, const_iterator> range(const K & _from, const K & _to) const {
+      return std::make_pair(lower_bound(_from), lower_bound(_to));
+    }
+
+    /**
+     * Method for getting size of one packed entry
+     * @param _alignment Alignment with which std::map was packed
+     * @return Size of one packed entry
+     */
+    static size_t getEntrySize(AlignMemory _alignment) {
+      return getAlignedOffset(getValueOffset(_alignment) + getAlignedSize(sizeof(V), _alignment),
+                              alignof(K), _alignment);
+    }
+
+    /**
+     * Method for getting size of packed entries.
+     * The last entry is not followed by padding up to alignment of the next key
+     * @param _size Number of entries
+     * @param _alignment Alignment with which std::map was packed
+     * @return Size of packed entries
+     */
+    static size_t getEntriesSize(const size_t _size, AlignMemory _alignment) {
+      return _size == 0 ? 0 : (_size - 1) * getEntrySize(_alignment) +
+                              getValueOffset(_alignment) + getAlignedSize(sizeof(V), _alignment);
+    }
+
+    /**
+     * Method for getting offset of value from the beginning of entry
+     * @param _alignment Alignment with which map is packed
+     * @return Offset of value in entry
+     */
+    static size_t getValueOffset(AlignMemory _alignment) {
+      return getAlignedOffset(getAlignedSize(sizeof(K), _alignment), alignof(V), _alignment);
+    }
+
+   private:
+    size_t value_offset_ = 0;
+  };
+
+  /**
+   * View over packed std::set with fixed size key.
+   * Allows O(log n) lookups and range scans directly on packed bytes
+   * @tparam K Type of key. Should be a trivial type
+   */
+  template <typename K>
+  class PackedSortedSetView
+      : public PackedSortedKeys<K> {
+   public:
+    PackedSortedSetView() = default;
+
+    /**
+     * Constructor of view over packed entries of std::set
+     * @param _pEntries Pointer to the first packed entry
+     * @param _size Number of packed entries
+     * @param _alignment Alignment with which std::set was packed
+     */
+    PackedSortedSetView(uint8_t const * _pEntries, const size_t _size, AlignMemory _alignment)
+        : PackedSortedKeys<K>(_pEntries, _size, getEntrySize(_alignment)) {
+    }
+
+    /**
+     * Method for getting size of one packed entry
+     * @param _alignment Alignment with which std::set was packed
+     * @return Size of one packed entry
+     */
+    static size_t getEntrySize(AlignMemory _alignment) {
+      return getAlignedOffset(getAlignedSize(sizeof(K), _alignment), alignof(K), _alignment);
+    }
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for PackedSortedMapView.
+   * Does not decode entries, only moves context after the packed std::map
+   */
+  template<typename K, typename V>
+  class UnpackBuffer::DelegateUnpackBuffer<PackedSortedMapView<K, V>> {
+   public:
+    template <typename TBufferContext>
+    static PackedSortedMapView<K, V> get(TBufferContext & _ctx) {
+      auto size = DelegateUnpackBuffer< typename std::map<K, V>::size_type >{}.get(_ctx);
+      _ctx.align(alignof(K));
+      PackedSortedMapView<K, V> result(_ctx.buffer(), size, _ctx.alignment());
+      _ctx += PackedSortedMapView<K, V>::getEntriesSize(size, _ctx.alignment());
+      return result;
+    }
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for PackedSortedSetView.
+   * Does not decode entries, only moves context after the packed std::set
+   */
+  template<typename K>
+  class UnpackBuffer::DelegateUnpackBuffer<PackedSortedSetView<K>> {
+   public:
+    template <typename TBufferContext>
+    static PackedSortedSetView<K> get(TBufferContext & _ctx) {
+      auto size = DelegateUnpackBuffer< typename std::set<K>::size_type >{}.get(_ctx);
+      _ctx.align(alignof(K));
+      PackedSortedSetView<K> result(_ctx.buffer(), size, _ctx.alignment());
+      _ctx += size * PackedSortedSetView<K>::getEntrySize(_ctx.alignment());
+      return result;
+    }
+  };
+}
+
+#endif //BUFFERS_PACKEDSORTEDMAPVIEW_HPP
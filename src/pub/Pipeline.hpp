@@ -0,0 +1,274 @@
+/**
+ * @file Pipeline.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains multi-stage pipeline of pooled buffers connected by bounded queues
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_PIPELINE_HPP
+#define BUFFERS_PIPELINE_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+
+#include "BufferPool.hpp"
+#include "BoundedQueue.hpp"
+#include "HeapPackBuffer.hpp"
+#include "Waiter.hpp"
+
+namespace buffers {
+  /**
+   * Pipeline of stages, for example pack -> compress -> checksum -> write,
+   * running on their own threads and connected by lock-free bounded queues of pooled buffers.
+   * Stage passes buffers to the next stage in the order of submit, even if it runs
+   * on several threads, so stage with one thread processes buffers in the order of submit.
+   * Full queue blocks previous stage and submit, so slow stage back-pressures producers.
+   * Idle threads of stages block on empty queue after short spinning
+   */
+  class Pipeline {
+   public:
+    /**
+     * Function of stage.
+     * Returns buffer for the next stage, it could be the same buffer or another buffer
+     * acquired from pool, then input buffer is released to pool.
+     * Returned nullptr drops the message
+     */
+    using Stage = std::function<HeapPackBuffer *(HeapPackBuffer *)>;
+
+    /**
+     * Constructor of pipeline
+     * @param _pool Pool of buffers passed through pipeline
+     * @param _queueCapacity Capacity of queue in front of every stage
+     */
+    Pipeline(BufferPool & _pool, const size_t _queueCapacity)
+        : pool_(_pool)
+        , queue_capacity_{_queueCapacity}
+        , running_{false}
+        , submit_seq_{0}
+        , submit_turn_{0}
+        , num_completed_{0} {
+    }
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    ~Pipeline() {
+      stop();
+    }
+
+    /**
+     * Method for adding stage to the end of pipeline.
+     * Should be called before start()
+     * @param _stage Function of stage
+     * @param _numThreads Number of threads running stage
+     * @return Index of stage
+     */
+    size_t addStage(Stage _stage, const size_t _numThreads = 1) {
+      stages_.emplace_back(new StageState(std::move(_stage), _numThreads > 0 ? _numThreads : 1, queue_capacity_));
+      return stages_.size() - 1;
+    }
+
+    /**
+     * Method for starting threads of stages
+     */
+    void start() {
+      if (running_.exchange(true)) {
+        return;
+      }
+      start_time_ = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < stages_.size(); ++i) {
+        stages_[i]->input.open();
+        stages_[i]->num_running.store(stages_[i]->num_threads, std::memory_order_relaxed);
+        for (size_t j = 0; j < stages_[i]->num_threads; ++j) {
+          threads_.emplace_back(&Pipeline::runStage, this, i);
+        }
+      }
+    }
+
+    /**
+     * Method for waiting until all submitted buffers passed pipeline and stopping threads.
+     * Queue of the first stage is closed, and every stage closes queue of the next stage
+     * when all its threads finished, so buffers in queues are processed before stopping.
+     * Should be called after all producers stopped submitting
+     */
+    void stop() {
+      if (!running_.exchange(false)) {
+        return;
+      }
+      if (!stages_.empty()) {
+        stages_.front()->input.close();
+      }
+      for (auto & thread : threads_) {
+        thread.join();
+      }
+      threads_.clear();
+    }
+
+    /**
+     * Method for acquiring empty buffer from pool of pipeline
+     * @return Pointer to the buffer owned by pool
+     */
+    HeapPackBuffer * acquire() {
+      return pool_.acquire();
+    }
+
+    /**
+     * Method for submitting packed buffer to the first stage.
+     * Waits while queue of the first stage is full
+     * @param _buffer Buffer acquired from pool of pipeline
+     */
+    void submit(HeapPackBuffer * _buffer) {
+      const size_t kSeq = submit_seq_.fetch_add(1, std::memory_order_acq_rel);
+      waitTurn(submit_turn_, submit_waiter_, kSeq);
+      if (stages_.empty()) {
+        pool_.release(_buffer);
+        num_completed_.fetch_add(1, std::memory_order_release);
+      } else {
+        stages_.front()->input.push(Item{kSeq, _buffer});
+      }
+      passTurn(submit_turn_, submit_waiter_, kSeq);
+    }
+
+    /**
+     * Method for getting number of stages
+     * @return Number of stages
+     */
+    size_t getNumStages() const {
+      return stages_.size();
+    }
+
+    /**
+     * Method for getting number of buffers which passed all stages or were dropped
+     * @return Number of completed buffers
+     */
+    size_t getNumCompleted() const {
+      return num_completed_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Method for getting number of buffers processed by stage
+     * @param _stageIdx Index of stage
+     * @return Number of processed buffers
+     */
+    size_t getNumProcessed(const size_t _stageIdx) const {
+      return stages_[_stageIdx]->num_processed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Method for getting utilisation of stage since start():
+     * time spent in function of stage divided by time of all threads of stage.
+     * Stage with utilisation close to 1 is a bottleneck
+     * @param _stageIdx Index of stage
+     * @return Utilisation of stage from 0 to 1
+     */
+    double getUtilisation(const size_t _stageIdx) const {
+      const auto kElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_time_).count();
+      if (kElapsed <= 0) {
+        return 0.0;
+      }
+      const StageState & stage = *stages_[_stageIdx];
+      return static_cast<double>(stage.busy_ns.load(std::memory_order_relaxed)) /
+             (static_cast<double>(kElapsed) * stage.num_threads);
+    }
+
+   private:
+    struct Item {
+      size_t seq;
+      HeapPackBuffer * buffer;
+    };
+
+    struct StageState {
+      StageState(Stage _function, const size_t _numThreads, const size_t _queueCapacity)
+          : function(std::move(_function))
+          , num_threads{_numThreads}
+          , input(_queueCapacity)
+          , num_running{0}
+          , turn{0}
+          , out_seq{0}
+          , num_processed{0}
+          , busy_ns{0} {
+      }
+
+      const Stage function;
+      const size_t num_threads;
+      BoundedQueue<Item> input;
+      /**
+       * Number of threads of stage which have not finished yet
+       */
+      std::atomic<size_t> num_running;
+      /**
+       * Sequence number of the next item which should be passed to the next stage
+       */
+      std::atomic<size_t> turn;
+      Waiter turn_waiter;
+      /**
+       * Sequence number for the next stage, changed only by thread which holds turn,
+       * so dropped messages do not leave gaps
+       */
+      size_t out_seq;
+      std::atomic<size_t> num_processed;
+      std::atomic<uint64_t> busy_ns;
+    };
+
+    static void waitTurn(const std::atomic<size_t> & _turn, Waiter & _waiter, const size_t _seq) {
+      _waiter.wait([&_turn, _seq]() {
+        return _turn.load(std::memory_order_acquire) == _seq;
+      });
+    }
+
+    static void passTurn(std::atomic<size_t> & _turn, Waiter & _waiter, const size_t _seq) {
+      _turn.store(_seq + 1, std::memory_order_release);
+      _waiter.notifyAll();
+    }
+
+    void runStage(const size_t _stageIdx) {
+      StageState & stage = *stages_[_stageIdx];
+      const bool kIsLast = _stageIdx + 1 == stages_.size();
+      Item item;
+      while (stage.input.pop(item)) {
+        const auto kStart = std::chrono::steady_clock::now();
+        HeapPackBuffer * output = stage.function(item.buffer);
+        stage.busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - kStart).count(), std::memory_order_relaxed);
+        stage.num_processed.fetch_add(1, std::memory_order_relaxed);
+        if (output != item.buffer) {
+          pool_.release(item.buffer);
+        }
+
+        waitTurn(stage.turn, stage.turn_waiter, item.seq);
+        if (output != nullptr && !kIsLast) {
+          stages_[_stageIdx + 1]->input.push(Item{stage.out_seq++, output});
+        } else {
+          if (output != nullptr) {
+            pool_.release(output);
+          }
+          num_completed_.fetch_add(1, std::memory_order_release);
+        }
+        passTurn(stage.turn, stage.turn_waiter, item.seq);
+      }
+      if (stage.num_running.fetch_sub(1, std::memory_order_acq_rel) == 1 && !kIsLast) {
+        stages_[_stageIdx + 1]->input.close();
+      }
+    }
+
+    BufferPool & pool_;
+    const size_t queue_capacity_;
+    std::vector<std::unique_ptr<StageState>> stages_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> running_;
+    std::atomic<size_t> submit_seq_;
+    std::atomic<size_t> submit_turn_;
+    Waiter submit_waiter_;
+    std::atomic<size_t> num_completed_;
+    std::chrono::steady_clock::time_point start_time_;
+  };
+}
+
+#endif //BUFFERS_PIPELINE_HPP
@@ -0,0 +1,170 @@
+/**
+ * @file RecordView.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains view for zero-parse access to packed records of fixed layout
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_RECORDVIEW_HPP
+#define BUFFERS_RECORDVIEW_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <tuple>
+#include <stdexcept>
+#include <type_traits>
+
+#include "AlignMemory.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Compile time layout of fields packed one after another with PackBuffer
+   * @tparam A Alignment with which record is packed
+   * @tparam Start Offset of the first field from the beginning of record
+   * @tparam Fields Types of fields in order of packing
+   */
+  template <AlignMemory A, size_t Start, typename... Fields>
+  struct FieldsLayout;
+
+  template <AlignMemory A, size_t Start>
+  struct FieldsLayout<A, Start> {
+    static constexpr size_t kEnd = Start;
+    static constexpr size_t kMaxAlignment = 1;
+
+    template <size_t N>
+    static constexpr size_t offset() {
+      return Start;
+    }
+  };
+
+  template <AlignMemory A, size_t Start, typename F, typename... Rest>
+  struct FieldsLayout<A, Start, F, Rest...> {
+#if __cplusplus > 199711L
+    static_assert(std::is_trivial<F>::value, "Type of field is not a trivial type !!");
+#endif
+
+    static constexpr size_t kOffset = getAlignedOffset(Start, alignof(F), A);
+    using Next = FieldsLayout<A, kOffset + getAlignedSize(sizeof(F), A), Rest...>;
+    static constexpr size_t kEnd = Next::kEnd;
+    static constexpr size_t kMaxAlignment =
+        alignof(F) > Next::kMaxAlignment ? alignof(F) : Next::kMaxAlignment;
+
+    template <size_t N>
+    static constexpr size_t offset() {
+      return N == 0 ? kOffset : Next::template offset<(N == 0 ? 0 : N - 1)>();
+    }
+  };
+
+  /**
+   * Compile time layout of record packed field by field with PackBuffer.
+   * For natural alignment record should start at offset multiple of kAlignment
+   * @tparam A Alignment with which record is packed
+   * @tparam Fields Types of fields in order of packing
+   */
+  template <AlignMemory A, typename... Fields>
+  struct RecordLayout {
+    static constexpr size_t kSize = FieldsLayout<A, 0, Fields...>::kEnd;
+    static constexpr size_t kAlignment =
+        A == AlignMemory::Natural ? FieldsLayout<A, 0, Fields...>::kMaxAlignment : 1;
+
+    /**
+     * Method for getting offset of field from the beginning of record
+     * @tparam N Index of field
+     * @return Offset of field
+     */
+    template <size_t N>
+    static constexpr size_t offset() {
+      return FieldsLayout<A, 0, Fields...>::template offset<N>();
+    }
+  };
+
+  /**
+   * View over record packed with PackBuffer field by field.
+   * Offset of every field is known at compile time, so reading of field
+   * is one unaligned-safe load without UnpackBuffer and without decoding
+   * of other fields
+   * @tparam A Alignment with which record is packed
+   * @tparam Fields Types of fields in order of packing. Should be trivial types
+   */
+  template <AlignMemory A, typename... Fields>
+  class RecordView {
+   public:
+    using Layout = RecordLayout<A, Fields...>;
+
+    template <size_t N>
+    using FieldType = typename std::tuple_element<N, std::tuple<Fields...>>::type;
+
+    /**
+     * Constructor of view over packed record
+     * @param _pData Pointer to the beginning of packed record
+     */
+    explicit RecordView(uint8_t const * _pData = nullptr)
+        : p_data_{_pData} {
+    }
+
+    /**
+     * Method for reading field of record
+     * @tparam N Index of field
+     * @return Value of field
+     */
+    template <size_t N>
+    FieldType<N> get() const {
+      FieldType<N> result;
+      std::memcpy(&result, p_data_ + Layout::template offset<N>(), sizeof(FieldType<N>));
+      return result;
+    }
+
+    /**
+     * Method for getting pointer to the packed record
+     * @return Pointer to the packed record
+     */
+    uint8_t const * getData() const {
+      return p_data_;
+    }
+
+    /**
+     * Method for getting size of packed record
+     * @return Size of packed record
+     */
+    static constexpr size_t getDataSize() {
+      return Layout::kSize;
+    }
+
+    static constexpr AlignMemory alignment() {
+      return A;
+    }
+
+   private:
+    uint8_t const * p_data_;
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for RecordView.
+   * Does not decode fields, only moves context after the packed record
+   */
+  template<AlignMemory A, typename... Fields>
+  class UnpackBuffer::DelegateUnpackBuffer<RecordView<A, Fields...>> {
+   public:
+    template <typename TBufferContext>
+    static RecordView<A, Fields...> get(TBufferContext & _ctx) {
+#ifdef __cpp_exceptions
+      if (_ctx.alignment() != A) {
+        throw std::invalid_argument("Alignment of RecordView differs from alignment of buffer !!");
+      }
+#endif
+      _ctx.align(alignof(typename std::tuple_element<0, std::tuple<Fields...>>::type));
+#ifdef __cpp_exceptions
+      if (_ctx.offset() % RecordLayout<A, Fields...>::kAlignment != 0) {
+        throw std::invalid_argument("RecordView is not placed at natural alignment of its fields !!");
+      }
+#endif
+      RecordView<A, Fields...> result(_ctx.buffer());
+      _ctx += RecordView<A, Fields...>::getDataSize();
+      return result;
+    }
+  };
+}
+
+#endif //BUFFERS_RECORDVIEW_HPP
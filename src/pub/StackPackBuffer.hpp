@@ -10,6 +10,7 @@
 #define BUFFERS_STACKPACKBUFFER_HPP
 
 #include <stdint.h>
+#include <cstddef>
 #include "PackBuffer.hpp"
 
 namespace buffers {
@@ -24,12 +25,12 @@ namespace buffers {
     static_assert(_Size > 0, "_Size should be more than 0");
 #endif
    public:
-    StackPackBuffer()
-        : PackBuffer(buffer_, _Size) {
+    StackPackBuffer(AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+        : PackBuffer(buffer_, _Size, _alignment) {
     }
 
    protected:
-    uint8_t buffer_[_Size];
+    alignas(alignof(std::max_align_t)) uint8_t buffer_[_Size];
   };
 }
 
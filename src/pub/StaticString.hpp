@@ -0,0 +1,201 @@
+/**
+ * @file StaticString.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains string with fixed capacity and inline storage for heap-free unpacking
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_STATICSTRING_HPP
+#define BUFFERS_STATICSTRING_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Null-terminated string with capacity known at compile time and inline storage.
+   * Never allocates memory. Packed exactly as std::string,
+   * so it could be unpacked as std::string and vice versa
+   * @tparam N Capacity of string without terminating null character
+   */
+  template <size_t N>
+  class StaticString {
+#if __cplusplus > 199711L
+    static_assert(N > 0, "N should be more than 0");
+#endif
+
+   public:
+    StaticString()
+        : size_{0} {
+      data_[0] = '\0';
+    }
+
+    /**
+     * Constructor from null-terminated string.
+     * Characters that do not fit in capacity are dropped
+     * @param _str Null-terminated string
+     */
+    StaticString(const char * _str)
+        : StaticString() {
+      assign(_str, std::strlen(_str));
+    }
+
+    static constexpr size_t capacity() {
+      return N;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    const char * c_str() const {
+      return data_;
+    }
+
+    const char * data() const {
+      return data_;
+    }
+
+    char operator[](const size_t _idx) const {
+      return data_[_idx];
+    }
+
+    /**
+     * Method for replacing content of string
+     * @param _str Pointer to the characters
+     * @param _size Number of characters
+     * @return Return true if all characters fit in capacity, false if they are truncated
+     */
+    bool assign(const char * _str, const size_t _size) {
+      size_ = _size < N ? _size : N;
+      std::memcpy(data_, _str, size_);
+      data_[size_] = '\0';
+      return size_ == _size;
+    }
+
+    /**
+     * Method for appending characters to the end of string
+     * @param _str Pointer to the characters
+     * @param _size Number of characters
+     * @return Return true if all characters fit in capacity, false if they are truncated
+     */
+    bool append(const char * _str, const size_t _size) {
+      const size_t kAppended = _size < N - size_ ? _size : N - size_;
+      std::memcpy(data_ + size_, _str, kAppended);
+      size_ += kAppended;
+      data_[size_] = '\0';
+      return kAppended == _size;
+    }
+
+    void clear() {
+      size_ = 0;
+      data_[0] = '\0';
+    }
+
+    std::string str() const {
+      return std::string(data_, size_);
+    }
+
+    bool operator==(const char * _str) const {
+      return std::strcmp(data_, _str) == 0;
+    }
+
+    bool operator!=(const char * _str) const {
+      return !(*this == _str);
+    }
+
+    template <size_t M>
+    bool operator==(const StaticString<M> & _other) const {
+      return size_ == _other.size() && std::memcmp(data_, _other.data(), size_) == 0;
+    }
+
+   private:
+    char data_[N + 1];
+    size_t size_;
+  };
+
+  /**
+   * Specialization DelegatePackBuffer class for StaticString.
+   * Packed as std::string
+   */
+  template <size_t N>
+  class PackBuffer::DelegatePackBuffer<StaticString<N>> {
+   public:
+    template <typename TBufferContext>
+    static bool put(TBufferContext & _ctx, const StaticString<N> & _str) {
+      return DelegatePackBuffer<char *>{}.put(_ctx, _str.c_str());
+    }
+
+    static size_t getTypeSize(const StaticString<N> & _str) {
+      return _str.size() + 1;
+    }
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for StaticString.
+   * Does not allocate memory. If packed string is longer than capacity,
+   * std::length_error is thrown, without exceptions string is truncated to
+   * capacity and the rest of characters is skipped.
+   * Invalid UTF-8 is unpacked as empty string if validation is enabled
+   * and exceptions are disabled
+   */
+  template <size_t N>
+  class UnpackBuffer::DelegateUnpackBuffer<StaticString<N>> {
+   public:
+    template <typename TBufferContext>
+    static StaticString<N> get(TBufferContext & _ctx) {
+      const char * pStr = reinterpret_cast<const char *>(_ctx.buffer());
+      size_t length;
+      bool isValid = true;
+      if (_ctx.isUtf8Validated()) {
+        isValid = Utf8::scanString(_ctx.buffer(), _ctx.buffer_size(), length);
+        if (!isValid) {
+#ifdef __cpp_exceptions
+          throw std::invalid_argument("String is not valid UTF-8 !!");
+#else
+          length = getLength(_ctx);
+#endif
+        }
+      } else {
+        length = getLength(_ctx);
+      }
+#ifdef __cpp_exceptions
+      if (length > N) {
+        throw std::length_error("Packed string exceeds capacity of StaticString !!");
+      }
+#endif
+      StaticString<N> result;
+      if (isValid) {
+        result.assign(pStr, length);
+      }
+      _ctx += length + 1;
+      return result;
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      _ctx += getLength(_ctx) + 1;
+    }
+
+   private:
+    template <typename TBufferContext>
+    static size_t getLength(TBufferContext & _ctx) {
+      const void * pEnd = std::memchr(_ctx.buffer(), '\0', _ctx.buffer_size());
+      return pEnd != nullptr
+             ? static_cast<size_t>(static_cast<const uint8_t *>(pEnd) - _ctx.buffer())
+             : _ctx.buffer_size();
+    }
+  };
+}
+
+#endif //BUFFERS_STATICSTRING_HPP
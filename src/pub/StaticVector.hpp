@@ -0,0 +1,209 @@
+/**
+ * @file StaticVector.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains vector with fixed capacity and inline storage for heap-free unpacking
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_STATICVECTOR_HPP
+#define BUFFERS_STATICVECTOR_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+  /**
+   * Vector with capacity known at compile time and inline storage.
+   * Never allocates memory. Packed exactly as std::vector<T>,
+   * so it could be unpacked as std::vector<T> and vice versa
+   * @tparam T Type of elements. Should be a trivial type
+   * @tparam N Capacity of vector
+   */
+  template <typename T, size_t N>
+  class StaticVector {
+#if __cplusplus > 199711L
+    static_assert(std::is_trivial<T>::value, "Type of elements is not a trivial type !!");
+    static_assert(N > 0, "N should be more than 0");
+#endif
+
+   public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+    StaticVector()
+        : size_{0} {
+    }
+
+    /**
+     * Constructor from list of elements.
+     * Elements that do not fit in capacity are dropped
+     * @param _list List of elements
+     */
+    StaticVector(std::initializer_list<T> _list)
+        : size_{0} {
+      for (const auto & value : _list) {
+        if (!push_back(value)) {
+          break;
+        }
+      }
+    }
+
+    static constexpr size_t capacity() {
+      return N;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    bool full() const {
+      return size_ == N;
+    }
+
+    T * data() {
+      return data_;
+    }
+
+    T const * data() const {
+      return data_;
+    }
+
+    T & operator[](const size_t _idx) {
+      return data_[_idx];
+    }
+
+    const T & operator[](const size_t _idx) const {
+      return data_[_idx];
+    }
+
+    iterator begin() {
+      return data_;
+    }
+
+    iterator end() {
+      return data_ + size_;
+    }
+
+    const_iterator begin() const {
+      return data_;
+    }
+
+    const_iterator end() const {
+      return data_ + size_;
+    }
+
+    /**
+     * Method for adding element to the end of vector
+     * @param _value Element for adding
+     * @return Return true if element is added, false if vector is full
+     */
+    bool push_back(const T & _value) {
+      if (size_ == N) {
+        return false;
+      }
+      data_[size_++] = _value;
+      return true;
+    }
+
+    void pop_back() {
+      if (size_ > 0) {
+        --size_;
+      }
+    }
+
+    void clear() {
+      size_ = 0;
+    }
+
+    /**
+     * Method for replacing content of vector by array of elements
+     * @param _pData Pointer to the first element
+     * @param _size Number of elements
+     * @return Return true if all elements fit in capacity, false if they are truncated
+     */
+    bool assign(T const * _pData, const size_t _size) {
+      size_ = _size < N ? _size : N;
+      if (size_ > 0) {
+        std::memcpy(data_, _pData, size_ * sizeof(T));
+      }
+      return size_ == _size;
+    }
+
+    bool operator==(const StaticVector & _other) const {
+      return size_ == _other.size_ &&
+             (size_ == 0 || std::memcmp(data_, _other.data_, size_ * sizeof(T)) == 0);
+    }
+
+    bool operator!=(const StaticVector & _other) const {
+      return !(*this == _other);
+    }
+
+   private:
+    T data_[N];
+    size_t size_;
+  };
+
+  /**
+   * Specialization DelegatePackBuffer class for StaticVector.
+   * Packed as std::vector<T>, empty vector is packed as zero number of elements
+   */
+  template <typename T, size_t N>
+  class PackBuffer::DelegatePackBuffer<StaticVector<T, N>> {
+   public:
+    template <typename TBufferContext>
+    static bool put(TBufferContext & _ctx, const StaticVector<T, N> & _vec) {
+      return DelegatePackBuffer<T>{}.put(_ctx, _vec.data(), _vec.size());
+    }
+
+    static size_t getTypeSize(const StaticVector<T, N> & _vec) {
+      return sizeof(size_t) + sizeof(T) * _vec.size();
+    }
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for StaticVector.
+   * Does not allocate memory. If packed vector has more elements than capacity,
+   * std::length_error is thrown, without exceptions vector is truncated to
+   * capacity and the rest of elements is skipped
+   */
+  template <typename T, size_t N>
+  class UnpackBuffer::DelegateUnpackBuffer<StaticVector<T, N>> {
+   public:
+    template <typename TBufferContext>
+    static StaticVector<T, N> get(TBufferContext & _ctx) {
+      const auto kSize = getArrayCount(_ctx);
+#ifdef __cpp_exceptions
+      if (kSize > N) {
+        throw std::length_error("Packed vector exceeds capacity of StaticVector !!");
+      }
+#endif
+      _ctx.align(alignof(T));
+      StaticVector<T, N> result;
+      result.assign(reinterpret_cast<T const *>(_ctx.buffer()), kSize);
+      _ctx += kSize * sizeof(T);
+      return result;
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      const auto kSize = getArrayCount(_ctx);
+      _ctx.align(alignof(T));
+      _ctx += kSize * sizeof(T);
+    }
+  };
+}
+
+#endif //BUFFERS_STATICVECTOR_HPP
@@ -0,0 +1,342 @@
+/**
+ * @file Tensor.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains dense tensor wire type with shape header and aligned payload
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_TENSOR_HPP
+#define BUFFERS_TENSOR_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "CopyEngine.hpp"
+
+namespace buffers {
+  /**
+   * Tag of type of tensor elements packed in front of tensor
+   */
+  enum class TensorType : uint8_t {
+    Int8 = 1,
+    UInt8 = 2,
+    Int16 = 3,
+    UInt16 = 4,
+    Int32 = 5,
+    UInt32 = 6,
+    Int64 = 7,
+    UInt64 = 8,
+    Float32 = 9,
+    Float64 = 10,
+  };
+
+  /**
+   * Mapping of type of elements to its tag
+   * @tparam T Type of tensor elements
+   */
+  template <typename T>
+  struct TensorTypeOf;
+
+  template <> struct TensorTypeOf<int8_t> { static constexpr TensorType value = TensorType::Int8; };
+  template <> struct TensorTypeOf<uint8_t> { static constexpr TensorType value = TensorType::UInt8; };
+  template <> struct TensorTypeOf<int16_t> { static constexpr TensorType value = TensorType::Int16; };
+  template <> struct TensorTypeOf<uint16_t> { static constexpr TensorType value = TensorType::UInt16; };
+  template <> struct TensorTypeOf<int32_t> { static constexpr TensorType value = TensorType::Int32; };
+  template <> struct TensorTypeOf<uint32_t> { static constexpr TensorType value = TensorType::UInt32; };
+  template <> struct TensorTypeOf<int64_t> { static constexpr TensorType value = TensorType::Int64; };
+  template <> struct TensorTypeOf<uint64_t> { static constexpr TensorType value = TensorType::UInt64; };
+  template <> struct TensorTypeOf<float> { static constexpr TensorType value = TensorType::Float32; };
+  template <> struct TensorTypeOf<double> { static constexpr TensorType value = TensorType::Float64; };
+
+  /**
+   * Non-owning view over dense multi-dimensional array.
+   * Packed as element type tag, rank, shape and payload in row-major order.
+   * Payload is packed as array of elements, so it is placed at array boundary
+   * if it is enabled (see PackBuffer::setArrayAlignment).
+   * View could be created over memory of caller with any strides for packing,
+   * view unpacked from buffer points directly into the packed payload
+   * @tparam T Type of elements, one of types with TensorTypeOf specialization
+   */
+  template <typename T>
+  class TensorView {
+#if __cplusplus > 199711L
+    static_assert(std::is_arithmetic<T>::value, "Type of elements is not an arithmetic type !!");
+#endif
+
+   public:
+    static constexpr size_t kMaxRank = 8;
+
+    TensorView()
+        : p_data_{nullptr}
+        , rank_{0} {
+    }
+
+    /**
+     * Constructor of view over dense row-major array
+     * @param _data Pointer to the first element
+     * @param _shape Number of elements in every dimension
+     */
+    TensorView(T const * _data, std::initializer_list<size_t> _shape)
+        : TensorView(_data, _shape.size(), _shape.begin(), nullptr) {
+    }
+
+    /**
+     * Constructor of view over strided array, for example sub-matrix or transposed matrix
+     * @param _data Pointer to the first element
+     * @param _shape Number of elements in every dimension
+     * @param _strides Distance between elements in every dimension, in elements
+     */
+    TensorView(T const * _data, std::initializer_list<size_t> _shape, std::initializer_list<size_t> _strides)
+        : TensorView(_data, _shape.size(), _shape.begin(), _strides.size() == _shape.size() ? _strides.begin() : nullptr) {
+    }
+
+    /**
+     * Constructor of view over strided array
+     * @param _data Pointer to the first element
+     * @param _rank Number of dimensions, not more than kMaxRank
+     * @param _shape Number of elements in every dimension
+     * @param _strides Distance between elements in every dimension in elements, nullptr for dense array
+     */
+    TensorView(T const * _data, const size_t _rank, size_t const * _shape, size_t const * _strides)
+        : p_data_{reinterpret_cast<uint8_t const *>(_data)}
+        , rank_{_rank} {
+      if (_rank > kMaxRank) {
+#ifdef __cpp_exceptions
+        throw std::length_error("Rank of tensor exceeds maximum rank !!");
+#else
+        p_data_ = nullptr;
+        rank_ = 0;
+        return;
+#endif
+      }
+      size_t denseStride = 1;
+      for (size_t i = rank_; i-- > 0;) {
+        shape_[i] = _shape[i];
+        strides_[i] = _strides != nullptr ? _strides[i] : denseStride;
+        denseStride *= shape_[i];
+      }
+    }
+
+    size_t rank() const {
+      return rank_;
+    }
+
+    size_t shape(const size_t _dim) const {
+      return shape_[_dim];
+    }
+
+    /**
+     * Method for getting distance between elements in dimension
+     * @param _dim Index of dimension
+     * @return Distance in elements
+     */
+    size_t stride(const size_t _dim) const {
+      return strides_[_dim];
+    }
+
+    /**
+     * Method for getting number of elements
+     * @return Product of all dimensions
+     */
+    size_t size() const {
+      size_t result = 1;
+      for (size_t i = 0; i < rank_; ++i) {
+        result *= shape_[i];
+      }
+      return result;
+    }
+
+    /**
+     * Method for getting pointer to the first element.
+     * Pointer could be dereferenced only if isAligned(alignof(T)) is true
+     * @return Pointer to the first element
+     */
+    T const * data() const {
+      return reinterpret_cast<T const *>(p_data_);
+    }
+
+    /**
+     * Method for checking if elements are placed in row-major order without gaps
+     * @return true if view is dense, false otherwise
+     */
+    bool isContiguous() const {
+      size_t denseStride = 1;
+      for (size_t i = rank_; i-- > 0;) {
+        if (shape_[i] != 1 && strides_[i] != denseStride) {
+          return false;
+        }
+        denseStride *= shape_[i];
+      }
+      return true;
+    }
+
+    /**
+     * Method for checking if address of the first element is multiple of boundary
+     * @param _boundary Boundary, power of two
+     * @return true if payload is aligned, false otherwise
+     */
+    bool isAligned(const size_t _boundary) const {
+      return (reinterpret_cast<uintptr_t>(p_data_) & (_boundary - 1)) == 0;
+    }
+
+    /**
+     * Method for reading element, safe for any alignment of payload
+     * @param _idx Index of element in every dimension
+     * @return Copy of element
+     */
+    template <typename ... TIdx>
+    T operator()(TIdx ... _idx) const {
+      const size_t kIdx[] = {static_cast<size_t>(_idx)...};
+      size_t offset = 0;
+      for (size_t i = 0; i < sizeof...(TIdx); ++i) {
+        offset += kIdx[i] * strides_[i];
+      }
+      T result;
+      std::memcpy(&result, p_data_ + offset * sizeof(T), sizeof(T));
+      return result;
+    }
+
+    /**
+     * Method for copying elements in row-major order to continuous memory
+     * @param _dst Destination of size() elements
+     */
+    void copyTo(uint8_t * _dst) const {
+      if (isContiguous()) {
+        CopyEngine::copy(_dst, p_data_, size() * sizeof(T));
+        return;
+      }
+      if (size() == 0) {
+        return;
+      }
+      const size_t kLast = rank_ - 1;
+      size_t idx[kMaxRank] = {};
+      for (;;) {
+        size_t offset = 0;
+        for (size_t i = 0; i < kLast; ++i) {
+          offset += idx[i] * strides_[i];
+        }
+        CopyEngine::gather(_dst, p_data_ + offset * sizeof(T), shape_[kLast], strides_[kLast] * sizeof(T), sizeof(T));
+        _dst += shape_[kLast] * sizeof(T);
+        size_t dim = kLast;
+        while (dim > 0 && ++idx[dim - 1] == shape_[dim - 1]) {
+          idx[--dim] = 0;
+        }
+        if (dim == 0) {
+          return;
+        }
+      }
+    }
+
+   private:
+    uint8_t const * p_data_;
+    size_t rank_;
+    size_t shape_[kMaxRank];
+    size_t strides_[kMaxRank];
+  };
+
+  /**
+   * Specialization DelegatePackBuffer class for TensorView.
+   * Elements are copied from memory of caller directly to the buffer,
+   * strided view is gathered into row-major order
+   */
+  template <typename T>
+  class PackBuffer::DelegatePackBuffer<TensorView<T>> {
+   public:
+    template <typename TBufferContext>
+    static bool put(TBufferContext & _ctx, const TensorView<T> & _tensor) {
+      if (_tensor.data() == nullptr || getTypeSize(_tensor) > _ctx.buffer_size()) {
+        return false;
+      }
+      uint8_t * const pStart = _ctx.buffer();
+      bool result = DelegatePackBuffer<uint8_t>{}.put(_ctx, static_cast<uint8_t>(TensorTypeOf<T>::value)) &&
+                    DelegatePackBuffer<size_t>{}.put(_ctx, _tensor.rank());
+      for (size_t i = 0; result && i < _tensor.rank(); ++i) {
+        result = DelegatePackBuffer<size_t>{}.put(_ctx, _tensor.shape(i));
+      }
+      const size_t kPayloadSize = _tensor.size() * sizeof(T);
+      result = result &&
+               putArrayCount(_ctx, _tensor.size(), kPayloadSize) &&
+               _ctx.align(alignof(T), kPayloadSize);
+      if (result) {
+        _tensor.copyTo(_ctx.buffer());
+        _ctx += kPayloadSize;
+      } else {
+        _ctx -= static_cast<size_t>(_ctx.buffer() - pStart);
+      }
+      return result;
+    }
+
+    static size_t getTypeSize(const TensorView<T> & _tensor) {
+      return sizeof(uint8_t) + sizeof(size_t) * (_tensor.rank() + 2) + _tensor.size() * sizeof(T);
+    }
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for TensorView.
+   * Does not copy elements, view points directly into the packed payload.
+   * If type tag does not match T or shape does not match payload,
+   * std::invalid_argument is thrown, without exceptions empty view is returned
+   */
+  template <typename T>
+  class UnpackBuffer::DelegateUnpackBuffer<TensorView<T>> {
+   public:
+    template <typename TBufferContext>
+    static TensorView<T> get(TBufferContext & _ctx) {
+      const auto kType = DelegateUnpackBuffer<uint8_t>{}.get(_ctx);
+      const auto kRank = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      if (kRank > TensorView<T>::kMaxRank) {
+#ifdef __cpp_exceptions
+        throw std::invalid_argument("Packed tensor does not match type of TensorView !!");
+#else
+        return TensorView<T>();
+#endif
+      }
+      size_t shape[TensorView<T>::kMaxRank];
+      size_t numElements = 1;
+      for (size_t i = 0; i < kRank; ++i) {
+        const auto kDim = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+        shape[i] = kDim;
+        numElements *= kDim;
+      }
+      const auto kSize = getArrayCount(_ctx);
+      _ctx.align(alignof(T));
+      uint8_t const * pData = _ctx.buffer();
+      _ctx += kSize * sizeof(T);
+      if (kType != static_cast<uint8_t>(TensorTypeOf<T>::value) || kSize != numElements) {
+#ifdef __cpp_exceptions
+        throw std::invalid_argument("Packed tensor does not match type of TensorView !!");
+#else
+        return TensorView<T>();
+#endif
+      }
+      return TensorView<T>(reinterpret_cast<T const *>(pData), kRank, shape, nullptr);
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      DelegateUnpackBuffer<uint8_t>{}.skip(_ctx);
+      const auto kRank = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      if (kRank > TensorView<T>::kMaxRank) {
+#ifdef __cpp_exceptions
+        throw std::invalid_argument("Packed tensor does not match type of TensorView !!");
+#else
+        return;
+#endif
+      }
+      for (size_t i = 0; i < kRank; ++i) {
+        DelegateUnpackBuffer<size_t>{}.skip(_ctx);
+      }
+      const auto kSize = getArrayCount(_ctx);
+      _ctx.align(alignof(T));
+      _ctx += kSize * sizeof(T);
+    }
+  };
+}
+
+#endif //BUFFERS_TENSOR_HPP
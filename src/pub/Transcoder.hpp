@@ -0,0 +1,236 @@
+/**
+ * @file Transcoder.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains transcoder of packed messages between alignments without decoding to objects
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_TRANSCODER_HPP
+#define BUFFERS_TRANSCODER_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <list>
+#include <set>
+#include <map>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <unordered_set>
+#include <unordered_map>
+
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "ArrayView.hpp"
+
+namespace buffers {
+  /**
+   * Transcoder of packed messages from one alignment to another,
+   * for example from AlignMemory::Bits_32 to tight AlignMemory::Bits_8 packing.
+   * Message is rewritten in one streaming pass driven by type of packed values:
+   * trivial values and arrays are copied from input to output,
+   * strings are copied without building std::string, containers are
+   * transcoded element by element. No objects are built and no memory is allocated.
+   * Support of user types is added by specialization of DelegateTranscoder
+   */
+  class Transcoder {
+   public:
+    /**
+     * Class which Transcoder delegate real transcoding of data for trivial type
+     * @tparam T Type of packed data. Should be a trivial type
+     */
+    template <typename T>
+    class DelegateTranscoder {
+#if __cplusplus > 199711L
+      static_assert(std::is_trivial<T>::value, "Type T is not a trivial type !!");
+#endif
+
+     public:
+      static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+        return _out.put(_in.get<T>());
+      }
+    };
+
+    /**
+     * Method for transcoding of packed values from input to output.
+     * Input and output could use different alignment and array alignment settings.
+     * If transcoding fails output is left partially packed and should be reset
+     * @tparam T Type of the first packed value
+     * @tparam Ts Types of the rest packed values
+     * @param _in Buffer positioned at the beginning of packed values
+     * @param _out Buffer where values are packed
+     * @return Return true if transcoding is succeed, false otherwise
+     */
+    template <typename T, typename ... Ts>
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      return DelegateTranscoder<T>{}.transcode(_in, _out) && TranscodeNext<Ts...>::transcode(_in, _out);
+    }
+
+   private:
+    template <typename ... Ts>
+    struct TranscodeNext {
+      static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+        return Transcoder::transcode<Ts...>(_in, _out);
+      }
+    };
+
+    /**
+     * Method for transcoding of number of elements followed by elements
+     * @tparam TElems Types of every element
+     */
+    template <typename ... TElems>
+    static bool transcodeElements(UnpackBuffer & _in, PackBuffer & _out) {
+      const auto kSize = _in.get<size_t>();
+      if (!_out.put(kSize)) {
+        return false;
+      }
+      for (size_t i = 0; i < kSize; ++i) {
+        if (!transcode<TElems...>(_in, _out)) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  template <>
+  struct Transcoder::TranscodeNext<> {
+    static bool transcode(UnpackBuffer &, PackBuffer &) {
+      return true;
+    }
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for null-terminated string.
+   * String is copied from input with terminating null character
+   */
+  template <>
+  class Transcoder::DelegateTranscoder<char *> {
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      const char * pStr = _in.get<const char *>();
+      return pStr != nullptr &&
+             _out.putRaw(reinterpret_cast<uint8_t const *>(pStr), std::strlen(pStr) + 1);
+    }
+  };
+
+  template <>
+  class Transcoder::DelegateTranscoder<const char *>
+      : public Transcoder::DelegateTranscoder<char *> {
+  };
+
+  template <>
+  class Transcoder::DelegateTranscoder<std::string>
+      : public Transcoder::DelegateTranscoder<char *> {
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for std::vector of trivial type.
+   * Array is copied in one block and placed at array boundary of output if it is enabled
+   * @tparam T Type of data under std::vector
+   */
+  template <typename T>
+  class Transcoder::DelegateTranscoder<std::vector<T>> {
+#if __cplusplus > 199711L
+    static_assert(std::is_trivial<T>::value, "Type of elements is not a trivial type !!");
+#endif
+
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      const auto kView = _in.get<ArrayView<T>>();
+      return _out.put(kView.data(), kView.size());
+    }
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for std::list
+   * @tparam T Type of data under std::list
+   */
+  template <typename T>
+  class Transcoder::DelegateTranscoder<std::list<T>> {
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      return transcodeElements<T>(_in, _out);
+    }
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for std::set
+   * @tparam K Type of data under std::set
+   */
+  template <typename K>
+  class Transcoder::DelegateTranscoder<std::set<K>> {
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      return transcodeElements<K>(_in, _out);
+    }
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for std::unordered_set
+   * @tparam K Type of data under std::unordered_set
+   */
+  template <typename K>
+  class Transcoder::DelegateTranscoder<std::unordered_set<K>> {
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      return transcodeElements<K>(_in, _out);
+    }
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for std::pair
+   * @tparam K First value of std::pair
+   * @tparam V Second value of std::pair
+   */
+  template <typename K, typename V>
+  class Transcoder::DelegateTranscoder<std::pair<K, V>> {
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      return Transcoder::transcode<K, V>(_in, _out);
+    }
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for std::map
+   * @tparam K Key of std::map
+   * @tparam V Value of std::map
+   */
+  template <typename K, typename V>
+  class Transcoder::DelegateTranscoder<std::map<K, V>> {
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      return transcodeElements<K, V>(_in, _out);
+    }
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for std::unordered_map
+   * @tparam K Key of std::unordered_map
+   * @tparam V Value of std::unordered_map
+   */
+  template <typename K, typename V>
+  class Transcoder::DelegateTranscoder<std::unordered_map<K, V>> {
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      return transcodeElements<K, V>(_in, _out);
+    }
+  };
+
+  /**
+   * Specialization DelegateTranscoder class for std::unique_ptr
+   * @tparam T Type of owned object
+   */
+  template <typename T>
+  class Transcoder::DelegateTranscoder<std::unique_ptr<T>> {
+   public:
+    static bool transcode(UnpackBuffer & _in, PackBuffer & _out) {
+      const auto kIsPresent = _in.get<uint8_t>();
+      return _out.put(kIsPresent) && (kIsPresent == 0 || Transcoder::transcode<T>(_in, _out));
+    }
+  };
+}
+
+#endif //BUFFERS_TRANSCODER_HPP
@@ -0,0 +1,38 @@
+/**
+ * @file TypeTag.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains tag of type which does not require RTTI
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_TYPETAG_HPP
+#define BUFFERS_TYPETAG_HPP
+
+#include <type_traits>
+
+namespace buffers {
+  /**
+   * Holder of tag of type, address of static object is unique for every type
+   * @tparam T Type
+   */
+  template <typename T>
+  struct TypeTag {
+    static const void * get() {
+      static const char kTag = 0;
+      return &kTag;
+    }
+  };
+
+  /**
+   * Method for getting tag of type
+   * @tparam T Type, cv-qualifiers are ignored
+   * @return Tag of type
+   */
+  template <typename T>
+  const void * getTypeTag() {
+    return TypeTag<typename std::remove_cv<T>::type>::get();
+  }
+}
+
+#endif //BUFFERS_TYPETAG_HPP
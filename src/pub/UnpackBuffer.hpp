@@ -15,11 +15,19 @@
 #include <list>
 #include <set>
 #include <map>
+#include <memory>
 #include <limits>
+#include <stdexcept>
 #include <unordered_set>
 #include <unordered_map>
+#include <type_traits>
 
 #include "AlignMemory.hpp"
+#include "CopyEngine.hpp"
+#include "Utf8.hpp"
+#include "Hash.hpp"
+#include "CompactCode.hpp"
+#include "TypeTag.hpp"
 
 namespace buffers {
   /**
@@ -47,7 +55,7 @@ namespace buffers {
         }
       #endif
 
-        const uint32_t kAlignedSize = getAlignedSize(_size);
+        const size_t kAlignedSize = getAlignedSize(_size);
         p_msg_ += kAlignedSize;
         msg_size_ += kAlignedSize;
         return *this;
@@ -60,7 +68,7 @@ namespace buffers {
         }
       #endif
 
-        const uint32_t kAlignedSize = getAlignedSize(_size);
+        const size_t kAlignedSize = getAlignedSize(_size);
         p_msg_ -= kAlignedSize;
         msg_size_ -= kAlignedSize;
         return *this;
@@ -74,24 +82,108 @@ namespace buffers {
         return (buf_size_ - msg_size_);
       }
 
+      AlignMemory alignment() const {
+        return alignment_;
+      }
+
+      /**
+       * Method for getting offset of the next position from the beginning of the message
+       * @return Offset of the next position
+       */
+      size_t offset() const {
+        return origin_ + msg_size_;
+      }
+
+      /**
+       * Method for checking if unpacked strings should be validated as UTF-8
+       * @return true if strings are validated, false otherwise
+       */
+      bool isUtf8Validated() const {
+        return validate_utf8_;
+      }
+
+      /**
+       * Method for getting number of shared objects met in the message
+       * @return Number of shared objects
+       */
+      size_t numShared() const {
+        return shared_objects_.size();
+      }
+
+      /**
+       * Method for reserving id for shared object before its unpacking
+       * @param _type Tag of type of shared object
+       * @return Id of shared object, ids start from 1
+       */
+      size_t addShared(const void * _type) {
+        shared_objects_.emplace_back(std::shared_ptr<void>(), _type);
+        return shared_objects_.size();
+      }
+
+      /**
+       * Method for storing unpacked shared object
+       * @param _id Id of shared object returned by addShared()
+       * @param _object Unpacked shared object
+       */
+      void setShared(const size_t _id, std::shared_ptr<void> _object) {
+        shared_objects_[_id - 1].first = std::move(_object);
+      }
+
+      /**
+       * Method for getting shared object unpacked earlier
+       * @param _id Id of shared object
+       * @return Shared object, null if object is still being unpacked
+       */
+      const std::shared_ptr<void> & shared(const size_t _id) const {
+        return shared_objects_[_id - 1].first;
+      }
+
+      /**
+       * Method for getting tag of type of shared object unpacked earlier
+       * @param _id Id of shared object
+       * @return Tag of type with which shared object was unpacked
+       */
+      const void * sharedType(const size_t _id) const {
+        return shared_objects_[_id - 1].second;
+      }
+
+      /**
+       * Method for moving next position in the message to the boundary of
+       * type alignment. Does something only for natural alignment of memory
+       * @param _typeAlignment Alignment of type of the next value, alignof(T)
+       * @return Return true if padding fits in the buffer, false otherwise
+       */
+      bool align(const size_t _typeAlignment) {
+        const size_t kPadding = getAlignedOffset(offset(), _typeAlignment, alignment_) - offset();
+        if (kPadding > buffer_size()) {
+          return false;
+        }
+        p_msg_ += kPadding;
+        msg_size_ += kPadding;
+        return true;
+      }
+
      private:
-      Context(uint8_t const * _pMsg, size_t _size, AlignMemory _alignment)
+      Context(uint8_t const * _pMsg, size_t _size, AlignMemory _alignment, size_t _origin)
           : buf_size_{_size}
           , p_msg_{_pMsg}
           , msg_size_{0}
-          , alignment_{_alignment} {
+          , alignment_{_alignment}
+          , origin_{_origin}
+          , validate_utf8_{false} {
       }
 
-      uint32_t getAlignedSize(const size_t & _size) const {
-        const auto kAlignedMemChunk = static_cast<uint32_t>(alignment_);
-        const uint32_t kNumChunks = _size / kAlignedMemChunk + (_size % kAlignedMemChunk == 0 ? 0 : 1);
-        return kNumChunks * kAlignedMemChunk;
+      size_t getAlignedSize(const size_t & _size) const {
+        return buffers::getAlignedSize(_size, alignment_);
       }
 
       const size_t buf_size_;
       uint8_t const * p_msg_;
       size_t msg_size_;
       AlignMemory alignment_;
+      size_t origin_;
+      bool validate_utf8_;
+      std::vector<std::pair<std::shared_ptr<void>, const void *>> shared_objects_;
     };
 
     /**
@@ -103,10 +195,61 @@ namespace buffers {
      public:
       template <typename TBufferContext>
       static T get(TBufferContext & _ctx) {
+        _ctx.align(alignof(T));
         const T &t = *(reinterpret_cast<const T *>(_ctx.buffer()));
         _ctx += sizeof(T);
         return std::move(t);
       }
+
+      template <typename TBufferContext>
+      static void skip(TBufferContext & _ctx) {
+        _ctx.align(alignof(T));
+        _ctx += sizeof(T);
+      }
+
+      /**
+       * Method for copying packed array directly into memory of caller
+       * @param _dst Pointer to the destination memory
+       * @param _capacity Number of elements that fit in destination
+       * @return Number of copied elements
+       */
+      template <typename TBufferContext>
+      static size_t getInto(TBufferContext & _ctx, T * _dst, const size_t _capacity) {
+        return getStrided(_ctx, _dst, _capacity, sizeof(T));
+      }
+
+      /**
+       * Method for copying packed array into memory of caller at equal distance
+       * @param _base Pointer to the first destination element
+       * @param _capacity Number of elements that fit in destination
+       * @param _stride Distance between destination elements in bytes
+       * @return Number of copied elements
+       */
+      template <typename TBufferContext>
+      static size_t getStrided(TBufferContext & _ctx, T * _base, const size_t _capacity, const size_t _stride) {
+#if __cplusplus > 199711L
+        static_assert(std::is_trivial<T>::value, "Type T is not a trivial type !!");
+#endif
+        const auto kSize = getArrayCount(_ctx);
+#ifdef __cpp_exceptions
+        if (kSize > _capacity) {
+          throw std::length_error("Packed array exceeds capacity of destination !!");
+        }
+#endif
+        if (!_ctx.align(alignof(T)) || kSize > _ctx.buffer_size() / sizeof(T)) {
+#ifdef __cpp_exceptions
+          throw std::length_error("Packed array exceeds size of buffer !!");
+#else
+          return 0;
+#endif
+        }
+        const size_t kNumCopied = kSize < _capacity ? kSize : _capacity;
+        if (kNumCopied > 0) {
+          CopyEngine::scatter(reinterpret_cast<uint8_t *>(_base), _stride, _ctx.buffer(), kNumCopied, sizeof(T));
+        }
+        _ctx += kSize * sizeof(T);
+        return kNumCopied;
+      }
     };
 
    public:
@@ -114,10 +257,14 @@ namespace buffers {
      * Constructor for unpacking buffer
      * @param _pMsg Pointer to the raw buffer
      * @param _size Size of raw buffer
+     * @param _alignment Alignment with which buffer was packed
+     * @param _origin Offset of raw buffer from the beginning of packed message,
+     *                used for natural alignment when only part of message is unpacked
      */
-    UnpackBuffer(uint8_t const * const _pMsg, const size_t _size, AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+    UnpackBuffer(uint8_t const * const _pMsg, const size_t _size,
+                 AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)), const size_t _origin = 0)
         : p_buf_(_pMsg)
-        , context_(_pMsg, _size, _alignment) {
+        , context_(_pMsg, _size, _alignment, _origin) {
     }
 
     /**
@@ -137,7 +284,7 @@ namespace buffers {
     template <typename T, size_t dataLen>
     UnpackBuffer(const T (&_buffer)[dataLen], AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
         : p_buf_(reinterpret_cast<uint8_t const *>(_buffer))
-        , context_(p_buf_, sizeof(T) * dataLen, _alignment) {
+        , context_(p_buf_, sizeof(T) * dataLen, _alignment, 0) {
     }
 
     /**
@@ -156,14 +303,203 @@ namespace buffers {
       return this->get<const char*>();
     }
 
+    /**
+     * Template getting array packed by PackBuffer::put(const T *, size_t), C-array or
+     * std::vector<T> directly into memory of caller without intermediate allocation.
+     * If packed array has more elements than capacity, std::length_error is thrown,
+     * without exceptions only capacity elements are copied and the rest are skipped.
+     * If packed array exceeds the rest of buffer, std::length_error is thrown,
+     * without exceptions nothing is copied and 0 is returned
+     * @tparam T Type of elements. Should be a trivial type
+     * @param _dst Pointer to the destination memory
+     * @param _capacity Number of elements that fit in destination
+     * @return Number of copied elements
+     */
+    template<typename T>
+    size_t getInto(T * _dst, const size_t _capacity) {
+      return DelegateUnpackBuffer<T>{}.getInto(context_, _dst, _capacity);
+    }
+
+    template<typename T, size_t dataLen>
+    size_t getInto(T (&_dst)[dataLen]) {
+      return getInto(static_cast<T *>(_dst), dataLen);
+    }
+
+    /**
+     * Template getting packed array into memory of caller at equal distance,
+     * for example to one field of array of structs or one column of row-major matrix.
+     * Overflow of capacity is handled as in getInto()
+     * @tparam T Type of elements. Should be a trivial type
+     * @param _base Pointer to the first destination element
+     * @param _capacity Number of elements that fit in destination
+     * @param _stride Distance between destination elements in bytes
+     * @return Number of copied elements
+     */
+    template<typename T>
+    size_t getStrided(T * _base, const size_t _capacity, const size_t _stride) {
+      return DelegateUnpackBuffer<T>{}.getStrided(context_, _base, _capacity, _stride);
+    }
+
+    /**
+     * Template skipping type T in the buffer without decoding
+     * @tparam T Type for skipping in buffer
+     */
+    template<typename T>
+    void skip() {
+      DelegateUnpackBuffer<T>{}.skip(context_);
+    }
+
+    /**
+     * Method for getting raw pointer to the beginning of packed buffer
+     * @return Raw pointer to the packed data
+     */
+    uint8_t const * getData() const {
+      return p_buf_;
+    }
+
+    /**
+     * Method for getting raw pointer to the next data to unpack
+     * @return Raw pointer to the next data to unpack
+     */
+    uint8_t const * getCurrentData() const {
+      return context_.buffer();
+    }
+
+    /**
+     * Method for getting size of the whole packed data.
+     * Size of buffer created without size is unknown,
+     * for it size of data unpacked so far is returned
+     * @return Size of packed data
+     */
+    size_t getDataSize() const {
+      return context_.buf_size_ != std::numeric_limits<size_t>::max() ? context_.buf_size_ : context_.msg_size_;
+    }
+
+    /**
+     * Method for getting 64 bit hash of the whole packed data without unpacking.
+     * Equal to PackBuffer::getHash() with the same seed.
+     * For buffer created without size only data unpacked so far is hashed
+     * @param _seed Seed of hash
+     * @return 64 bit hash of packed data
+     */
+    uint64_t getHash(const uint64_t _seed = 0) const {
+      return Hash64::hash(p_buf_, getDataSize(), _seed);
+    }
+
+    /**
+     * Method for getting 128 bit hash of the whole packed data without unpacking.
+     * For buffer created without size only data unpacked so far is hashed
+     * @param _seed Seed of hash
+     * @return 128 bit hash of packed data
+     */
+    Hash128 getHash128(const uint64_t _seed = 0) const {
+      return Hash64::hash128(p_buf_, getDataSize(), _seed);
+    }
+
+    /**
+     * Method for getting size of data left to unpack
+     * @return Size of data left to unpack
+     */
+    size_t getBufferSize() const {
+      return context_.buffer_size();
+    }
+
+    /**
+     * Method for getting alignment of packed buffer
+     * @return Alignment of packed buffer
+     */
+    AlignMemory getAlignment() const {
+      return context_.alignment();
+    }
+
+    /**
+     * Method for enabling validation of unpacked strings as UTF-8.
+     * Validation is fused with searching of terminating null character.
+     * Invalid string causes std::invalid_argument, without exceptions
+     * null pointer or empty string is returned
+     * @param _validate true to validate strings, false otherwise
+     */
+    void setUtf8Validation(const bool _validate) {
+      context_.validate_utf8_ = _validate;
+    }
+
     /**
      * Method for reset unpacking data from the buffer
      */
     void reset() {
       context_ -= context_.msg_size_;
+      context_.shared_objects_.clear();
     }
 
    private:
+    /**
+     * Method for unpacking number of elements of array of trivial type.
+     * If number is packed with kArrayPaddingFlag, recorded padding in front of
+     * array payload placed at array boundary is skipped
+     * @param _ctx Context of buffer
+     * @return Number of elements of array
+     */
+    template <typename TBufferContext>
+    static size_t getArrayCount(TBufferContext & _ctx);
+
+    /**
+     * Method for unpacking elements of node based container.
+     * In PUB_COMPACT_CODE mode elements are unpacked by shared getElementsShared
+     * @param _ctx Context of buffer
+     * @param _container Container to which elements are inserted
+     * @param _getElement Callable that unpacks one element and inserts it into _container
+     */
+    template <typename TBufferContext, typename TGetElement>
+    static void getElements(TBufferContext & _ctx, void * _container, TGetElement _getElement) {
+#ifdef PUB_COMPACT_CODE
+      getElementsShared(_ctx, _container, _getElement);
+#else
+      const auto kSize = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      for (size_t i = 0; i < kSize; ++i) {
+        _getElement(_ctx, _container);
+      }
+#endif
+    }
+
+    /**
+     * Method for skipping elements of node based container.
+     * In PUB_COMPACT_CODE mode elements are skipped by shared skipElementsShared
+     * @param _ctx Context of buffer
+     * @param _skipElement Callable that skips one element
+     */
+    template <typename TBufferContext, typename TSkipElement>
+    static void skipElements(TBufferContext & _ctx, TSkipElement _skipElement) {
+#ifdef PUB_COMPACT_CODE
+      skipElementsShared(_ctx, _skipElement);
+#else
+      const auto kSize = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      for (size_t i = 0; i < kSize; ++i) {
+        _skipElement(_ctx);
+      }
+#endif
+    }
+
+#ifdef PUB_COMPACT_CODE
+    /**
+     * Loops over elements shared by all types of containers,
+     * only callable that handles one element is instantiated for every type
+     */
+    static BUFFERS_NOINLINE void getElementsShared(Context & _ctx, void * _container,
+                                                   void (*_getElement)(Context &, void *)) {
+      const auto kSize = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      for (size_t i = 0; i < kSize; ++i) {
+        _getElement(_ctx, _container);
+      }
+    }
+
+    static BUFFERS_NOINLINE void skipElementsShared(Context & _ctx, void (*_skipElement)(Context &)) {
+      const auto kSize = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      for (size_t i = 0; i < kSize; ++i) {
+        _skipElement(_ctx);
+      }
+    }
+#endif
+
     const uint8_t * const p_buf_;
     Context context_;
   };
@@ -175,6 +511,15 @@ namespace buffers {
   template<>
   char *UnpackBuffer::get<char*>() = delete;
 
+  template <typename TBufferContext>
+  size_t UnpackBuffer::getArrayCount(TBufferContext & _ctx) {
+    const auto kCount = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+    if ((kCount & kArrayPaddingFlag) != 0) {
+      _ctx += DelegateUnpackBuffer<size_t>{}.get(_ctx);
+    }
+    return kCount & ~kArrayPaddingFlag;
+  }
+
   template<>
   class UnpackBuffer::DelegateUnpackBuffer<const char *> {
    public:
@@ -185,8 +530,42 @@ namespace buffers {
     template <typename TBufferContext>
     static const char *get(TBufferContext & _ctx) {
       const char *t = reinterpret_cast<const char *>(_ctx.buffer());
-      _ctx += std::strlen(t) + 1;
-      return t;
+      size_t length;
+      const bool kIsValid = getLength(_ctx, length);
+      _ctx += length + 1;
+      return kIsValid ? t : nullptr;
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      _ctx += std::strlen(reinterpret_cast<const char *>(_ctx.buffer())) + 1;
+    }
+
+    /**
+     * Method for getting length of string at the next position,
+     * string is validated as UTF-8 if validation is enabled
+     * @param _ctx Context of buffer
+     * @param _length Length of string without terminating null character,
+     *                also for invalid string, so it could be skipped
+     * @return Return false if string is not valid UTF-8 and exceptions are disabled, true otherwise
+     */
+    static BUFFERS_COMPACT_NOINLINE bool getLength(Context & _ctx, size_t & _length) {
+      if (!_ctx.isUtf8Validated()) {
+        _length = std::strlen(reinterpret_cast<const char *>(_ctx.buffer()));
+        return true;
+      }
+      if (!Utf8::scanString(_ctx.buffer(), _ctx.buffer_size(), _length)) {
+#ifdef __cpp_exceptions
+        throw std::invalid_argument("String is not valid UTF-8 !!");
+#else
+        const void * pEnd = std::memchr(_ctx.buffer(), '\0', _ctx.buffer_size());
+        _length = pEnd != nullptr
+                  ? static_cast<size_t>(static_cast<const uint8_t *>(pEnd) - _ctx.buffer())
+                  : _ctx.buffer_size();
+        return false;
+#endif
+      }
+      return true;
     }
   };
 
@@ -195,9 +574,18 @@ namespace buffers {
    public:
     template <typename TBufferContext>
     static std::string get(TBufferContext & _ctx) {
-      std::string result = DelegateUnpackBuffer<const char*>{}.get(_ctx);
+      const char *t = reinterpret_cast<const char *>(_ctx.buffer());
+      size_t length;
+      const bool kIsValid = DelegateUnpackBuffer<const char*>{}.getLength(_ctx, length);
+      _ctx += length + 1;
+      std::string result = kIsValid ? std::string(t, length) : std::string();
       return std::move(result);
     }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      DelegateUnpackBuffer<const char*>{}.skip(_ctx);
+    }
   };
 
   template<typename T>
@@ -205,12 +593,59 @@ namespace buffers {
    public:
     template <typename TBufferContext>
     static std::vector<T> get(TBufferContext & _ctx) {
-      std::vector<T> result;
-      auto size = DelegateUnpackBuffer< typename std::vector<T>::size_type >{}.get(_ctx);
-      for (int i = 0; i < size; ++i) {
-        result.push_back(DelegateUnpackBuffer<T>{}.get(_ctx));
+      return getVector<T>(_ctx);
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      skipVector<T>(_ctx);
+    }
+
+   private:
+    /**
+     * Elements of trivial type are packed as one continuous block,
+     * so they are unpacked with one bulk copy
+     */
+    template <typename TT, typename TBufferContext>
+    static typename std::enable_if<(std::is_trivial<TT>::value), std::vector<TT>>::type
+    getVector(TBufferContext & _ctx) {
+      auto size = getArrayCount(_ctx);
+      _ctx.align(alignof(TT));
+      uint8_t const * pData = _ctx.buffer();
+      _ctx += size * sizeof(TT);
+      std::vector<TT> result(size);
+      if (size > 0) {
+        CopyEngine::copy(reinterpret_cast<uint8_t *>(result.data()), pData, size * sizeof(TT));
       }
-      return std::move(result);
+      return result;
+    }
+
+    template <typename TT, typename TBufferContext>
+    static typename std::enable_if<!(std::is_trivial<TT>::value), std::vector<TT>>::type
+    getVector(TBufferContext & _ctx) {
+      std::vector<TT> result;
+      auto size = DelegateUnpackBuffer< typename std::vector<TT>::size_type >{}.get(_ctx);
+      result.reserve(size);
+      for (size_t i = 0; i < size; ++i) {
+        result.push_back(DelegateUnpackBuffer<TT>{}.get(_ctx));
+      }
+      return result;
+    }
+
+    template <typename TT, typename TBufferContext>
+    static typename std::enable_if<(std::is_trivial<TT>::value)>::type
+    skipVector(TBufferContext & _ctx) {
+      auto size = getArrayCount(_ctx);
+      _ctx.align(alignof(TT));
+      _ctx += size * sizeof(TT);
+    }
+
+    template <typename TT, typename TBufferContext>
+    static typename std::enable_if<!(std::is_trivial<TT>::value)>::type
+    skipVector(TBufferContext & _ctx) {
+      skipElements(_ctx, [](TBufferContext & _elemCtx) {
+        DelegateUnpackBuffer<TT>{}.skip(_elemCtx);
+      });
     }
   };
 
@@ -220,12 +655,18 @@ namespace buffers {
     template <typename TBufferContext>
     static std::list<T> get(TBufferContext & _ctx) {
       std::list<T> result;
-      auto size = DelegateUnpackBuffer< typename std::vector<T>::size_type >{}.get(_ctx);
-      for (int i = 0; i < size; ++i) {
-        result.push_back(DelegateUnpackBuffer<T>{}.get(_ctx));
-      }
+      getElements(_ctx, &result, [](TBufferContext & _elemCtx, void * _result) {
+        static_cast<std::list<T> *>(_result)->push_back(DelegateUnpackBuffer<T>{}.get(_elemCtx));
+      });
       return std::move(result);
     }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      skipElements(_ctx, [](TBufferContext & _elemCtx) {
+        DelegateUnpackBuffer<T>{}.skip(_elemCtx);
+      });
+    }
   };
 
   template<typename K>
@@ -234,13 +675,18 @@ namespace buffers {
     template <typename TBufferContext>
     static std::set<K> get(TBufferContext & _ctx) {
       std::set<K> result;
-      auto size = DelegateUnpackBuffer< typename std::set<K>::size_type >{}.get(_ctx);
-      for (int i = 0; i < size; ++i) {
-        auto key = DelegateUnpackBuffer<K>{}.get(_ctx);
-        result.insert(key);
-      }
+      getElements(_ctx, &result, [](TBufferContext & _elemCtx, void * _result) {
+        static_cast<std::set<K> *>(_result)->insert(DelegateUnpackBuffer<K>{}.get(_elemCtx));
+      });
       return std::move(result);
     }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      skipElements(_ctx, [](TBufferContext & _elemCtx) {
+        DelegateUnpackBuffer<K>{}.skip(_elemCtx);
+      });
+    }
   };
 
   template<typename K, typename V>
@@ -253,6 +699,12 @@ namespace buffers {
       result.second = DelegateUnpackBuffer<V>{}.get(_ctx);
       return std::move(result);
     }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      DelegateUnpackBuffer<K>{}.skip(_ctx);
+      DelegateUnpackBuffer<V>{}.skip(_ctx);
+    }
   };
 
   template<typename K, typename V>
@@ -261,14 +713,21 @@ namespace buffers {
     template <typename TBufferContext>
     static std::map<K, V> get(TBufferContext & _ctx) {
       std::map<K, V> result;
-      auto size = DelegateUnpackBuffer< typename std::map<K, V>::size_type >{}.get(_ctx);
-      for (int i = 0; i < size; ++i) {
-        auto key = DelegateUnpackBuffer<K>{}.get(_ctx);
-        auto value = DelegateUnpackBuffer<V>{}.get(_ctx);
-        result[key] = value;
-      }
+      getElements(_ctx, &result, [](TBufferContext & _elemCtx, void * _result) {
+        auto key = DelegateUnpackBuffer<K>{}.get(_elemCtx);
+        auto value = DelegateUnpackBuffer<V>{}.get(_elemCtx);
+        (*static_cast<std::map<K, V> *>(_result))[key] = value;
+      });
       return std::move(result);
     }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      skipElements(_ctx, [](TBufferContext & _elemCtx) {
+        DelegateUnpackBuffer<K>{}.skip(_elemCtx);
+        DelegateUnpackBuffer<V>{}.skip(_elemCtx);
+      });
+    }
   };
 
   template<typename K>
@@ -277,13 +736,18 @@ namespace buffers {
     template <typename TBufferContext>
     static std::unordered_set<K> get(TBufferContext & _ctx) {
       std::unordered_set<K> result;
-      auto size = DelegateUnpackBuffer< typename std::unordered_set<K>::size_type >{}.get(_ctx);
-      for (int i = 0; i < size; ++i) {
-        auto key = DelegateUnpackBuffer<K>{}.get(_ctx);
-        result.insert(key);
-      }
+      getElements(_ctx, &result, [](TBufferContext & _elemCtx, void * _result) {
+        static_cast<std::unordered_set<K> *>(_result)->insert(DelegateUnpackBuffer<K>{}.get(_elemCtx));
+      });
       return std::move(result);
     }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      skipElements(_ctx, [](TBufferContext & _elemCtx) {
+        DelegateUnpackBuffer<K>{}.skip(_elemCtx);
+      });
+    }
   };
 
   template<typename K, typename V>
@@ -292,16 +756,102 @@ namespace buffers {
     template <typename TBufferContext>
     static std::unordered_map<K, V> get(TBufferContext & _ctx) {
       std::unordered_map<K, V> result;
-      auto size = DelegateUnpackBuffer< typename std::unordered_map<K, V>::size_type >{}.get(_ctx);
-      for (int i = 0; i < size; ++i) {
-        auto key = DelegateUnpackBuffer<K>{}.get(_ctx);
-        auto value = DelegateUnpackBuffer<V>{}.get(_ctx);
-        result[key] = value;
-      }
+      getElements(_ctx, &result, [](TBufferContext & _elemCtx, void * _result) {
+        auto key = DelegateUnpackBuffer<K>{}.get(_elemCtx);
+        auto value = DelegateUnpackBuffer<V>{}.get(_elemCtx);
+        (*static_cast<std::unordered_map<K, V> *>(_result))[key] = value;
+      });
       return std::move(result);
     }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      skipElements(_ctx, [](TBufferContext & _elemCtx) {
+        DelegateUnpackBuffer<K>{}.skip(_elemCtx);
+        DelegateUnpackBuffer<V>{}.skip(_elemCtx);
+      });
+    }
   };
 
+  /**
+   * Specialization DelegateUnpackBuffer class for std::shared_ptr.
+   * Objects packed once and referenced by id several times are unpacked once,
+   * so sharing of objects is restored. Cycles of shared objects are not supported.
+   * Reference to object unpacked with another type throws std::invalid_argument,
+   * without exceptions null pointer is returned
+   * @tparam T Type of shared object
+   */
+  template<typename T>
+  class UnpackBuffer::DelegateUnpackBuffer<std::shared_ptr<T>> {
+   public:
+    template <typename TBufferContext>
+    static std::shared_ptr<T> get(TBufferContext & _ctx) {
+      const auto kId = DelegateUnpackBuffer<size_t>{}.get(_ctx);
+      if (kId == 0) {
+        return nullptr;
+      }
+      if (kId <= _ctx.numShared()) {
+        if (_ctx.sharedType(kId) != getTypeTag<T>()) {
+#ifdef __cpp_exceptions
+          throw std::invalid_argument("Shared object is referenced with another type !!");
+#else
+          return nullptr;
+#endif
+        }
+        return std::static_pointer_cast<T>(_ctx.shared(kId));
+      }
+      if (kId != _ctx.numShared() + 1) {
+#ifdef __cpp_exceptions
+        throw std::invalid_argument("Id of shared object is out of order !!");
+#else
+        return nullptr;
+#endif
+      }
+      _ctx.addShared(getTypeTag<T>());
+      std::shared_ptr<T> result = std::make_shared<T>(DelegateUnpackBuffer<T>{}.get(_ctx));
+      _ctx.setShared(kId, result);
+      return result;
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      get(_ctx);
+    }
+  };
+
+  /**
+   * Specialization DelegateUnpackBuffer class for std::unique_ptr
+   * @tparam T Type of owned object
+   */
+  template<typename T>
+  class UnpackBuffer::DelegateUnpackBuffer<std::unique_ptr<T>> {
+   public:
+    template <typename TBufferContext>
+    static std::unique_ptr<T> get(TBufferContext & _ctx) {
+      if (DelegateUnpackBuffer<uint8_t>{}.get(_ctx) == 0) {
+        return nullptr;
+      }
+      return std::unique_ptr<T>(new T(DelegateUnpackBuffer<T>{}.get(_ctx)));
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      if (DelegateUnpackBuffer<uint8_t>{}.get(_ctx) != 0) {
+        DelegateUnpackBuffer<T>{}.skip(_ctx);
+      }
+    }
+  };
+
+  /**
+   * Method for comparing packed messages without unpacking
+   * @return true if messages are packed to the same bytes, false otherwise
+   */
+  inline bool isEqualPacked(const UnpackBuffer & _lhs, const UnpackBuffer & _rhs) {
+    return _lhs.getAlignment() == _rhs.getAlignment() &&
+           _lhs.getDataSize() == _rhs.getDataSize() &&
+           std::memcmp(_lhs.getData(), _rhs.getData(), _lhs.getDataSize()) == 0;
+  }
+
   template <typename T>
   UnpackBuffer& operator>>(UnpackBuffer& unbuffer, T & t) {
     t = unbuffer.get<T>();
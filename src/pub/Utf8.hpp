@@ -0,0 +1,347 @@
+/**
+ * @file Utf8.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains UTF-8 validation used by buffers for unpacking of untrusted strings
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_UTF8_HPP
+#define BUFFERS_UTF8_HPP
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "CpuFeatures.hpp"
+
+#ifdef BUFFERS_X86_SIMD
+#include <immintrin.h>
+#define BUFFERS_SIMD_UTF8 1
+#endif
+
+namespace buffers {
+  /**
+   * Validation of UTF-8 encoded data.
+   * With AVX2 data is validated 32 bytes at a time, multibyte sequences included:
+   * every pair of adjacent bytes is classified by three table lookups and
+   * continuation bytes are checked against leads up to three bytes back
+   * (algorithm of Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte").
+   * Without AVX2 runs of ASCII characters are skipped 16 bytes at a time with SSE2.
+   * Bytes not covered by SIMD blocks are checked by scalar decoder, which rejects
+   * overlong encodings, surrogates and code points above U+10FFFF
+   */
+  class Utf8 {
+   public:
+    /**
+     * Method for validating data of known size
+     * @param _pData Pointer to the data
+     * @param _size Size of data
+     * @return true if data is valid UTF-8, false otherwise
+     */
+    static bool validate(uint8_t const * _pData, const size_t _size) {
+      size_t length;
+      return scan(_pData, _size, false, length);
+    }
+
+    /**
+     * Method for finding terminating null character of string and validating it in one pass
+     * @param _pStr Pointer to the string
+     * @param _maxSize Maximum size of string with terminating null character
+     * @param _length Length of string without terminating null character
+     * @return true if string is terminated and valid UTF-8, false otherwise
+     */
+    static bool scanString(uint8_t const * _pStr, const size_t _maxSize, size_t & _length) {
+      return scan(_pStr, _maxSize, true, _length);
+    }
+
+    /**
+     * Method for checking if CPU supports SIMD validation
+     * @return true if SIMD validation is supported, false otherwise
+     */
+    static bool isSimdSupported() {
+#ifdef BUFFERS_SIMD_UTF8
+      return CpuFeatures::hasSse2();
+#else
+      return false;
+#endif
+    }
+
+   private:
+    /**
+     * Size of block after which scalar decoder gives control back to SIMD routines
+     */
+    static constexpr size_t kBlockSize = 32;
+
+    /**
+     * Size of the smallest page. Terminated string could end right before unmapped page,
+     * so its blocks are loaded only if they do not cross page boundary
+     */
+    static constexpr size_t kPageSize = 4096;
+
+    static bool scan(uint8_t const * _pData, const size_t _size, const bool _stopAtNull, size_t & _length) {
+      const bool kIsSimdSupported = isSimdSupported();
+      size_t i = 0;
+      while (i < _size) {
+        i += skipValidSimd(_pData + i, _size - i, _stopAtNull);
+        const size_t kScalarEnd = kIsSimdSupported && _size - i > kBlockSize ? i + kBlockSize : _size;
+        while (i < kScalarEnd) {
+          const uint8_t kLead = _pData[i];
+          if (kLead < 0x80) {
+            if (kLead == 0 && _stopAtNull) {
+              _length = i;
+              return true;
+            }
+            ++i;
+          } else {
+            const size_t kSeqSize = getSequenceSize(_pData + i, _size - i);
+            if (kSeqSize == 0) {
+              _length = i;
+              return false;
+            }
+            i += kSeqSize;
+          }
+        }
+      }
+      _length = _size;
+      return !_stopAtNull;
+    }
+
+    /**
+     * Method for checking one multibyte sequence
+     * @return Size of valid sequence, 0 if sequence is invalid
+     */
+    static size_t getSequenceSize(uint8_t const * _pSeq, const size_t _size) {
+      const uint8_t kLead = _pSeq[0];
+      size_t seqSize;
+      uint8_t low = 0x80;
+      uint8_t high = 0xBF;
+      if (kLead >= 0xC2 && kLead <= 0xDF) {
+        seqSize = 2;
+      } else if (kLead >= 0xE0 && kLead <= 0xEF) {
+        seqSize = 3;
+        if (kLead == 0xE0) {
+          low = 0xA0;
+        } else if (kLead == 0xED) {
+          high = 0x9F;
+        }
+      } else if (kLead >= 0xF0 && kLead <= 0xF4) {
+        seqSize = 4;
+        if (kLead == 0xF0) {
+          low = 0x90;
+        } else if (kLead == 0xF4) {
+          high = 0x8F;
+        }
+      } else {
+        return 0;
+      }
+      if (_size < seqSize || _pSeq[1] < low || _pSeq[1] > high) {
+        return 0;
+      }
+      for (size_t i = 2; i < seqSize; ++i) {
+        if ((_pSeq[i] & 0xC0) != 0x80) {
+          return 0;
+        }
+      }
+      return seqSize;
+    }
+
+    /**
+     * Method for skipping data validated by SIMD routines
+     * @return Size of validated data, it always ends at boundary of character
+     */
+    static size_t skipValidSimd(uint8_t const * _pData, const size_t _size, const bool _stopAtNull) {
+#ifdef BUFFERS_SIMD_UTF8
+      if (CpuFeatures::hasAvx2()) {
+        return validateAvx2(_pData, _size, _stopAtNull);
+      }
+      if (CpuFeatures::hasSse2()) {
+        return skipAsciiSse2(_pData, _size, _stopAtNull);
+      }
+#endif
+      return 0;
+    }
+
+#ifdef BUFFERS_SIMD_UTF8
+    static bool isCrossingPage(uint8_t const * _pBlock, const size_t _blockSize) {
+      return (reinterpret_cast<uintptr_t>(_pBlock) & (kPageSize - 1)) > kPageSize - _blockSize;
+    }
+
+    /**
+     * Method for moving end of validated blocks back to the lead byte of
+     * the last character, which could continue in the next block
+     */
+    static size_t getCharBoundary(uint8_t const * _pData, const size_t _end) {
+      for (size_t i = 1; i <= 3 && i <= _end; ++i) {
+        const uint8_t kByte = _pData[_end - i];
+        if (kByte < 0x80) {
+          break;
+        }
+        if (kByte >= 0xC0) {
+          return _end - i;
+        }
+      }
+      return _end;
+    }
+
+    /**
+     * Errors of pair of adjacent bytes, set in tables of the first and the second byte.
+     * Pair is invalid if some error is set in all three tables
+     */
+    enum : uint8_t {
+      kTooShort = 1 << 0,     // 11______ 0_______ or 11______ 11______
+      kTooLong = 1 << 1,      // 0_______ 10______
+      kOverlong3 = 1 << 2,    // 11100000 100_____
+      kTooLarge = 1 << 3,     // 11110100 1001____, 11110100 101_____ and larger leads
+      kSurrogate = 1 << 4,    // 11101101 101_____
+      kOverlong2 = 1 << 5,    // 1100000_ 10______
+      kTooLarge1000 = 1 << 6, // 11110101 1000____ and larger leads
+      kOverlong4 = 1 << 6,    // 11110000 1000____
+      kTwoConts = 1 << 7,     // 10______ 10______, valid only for the third and the fourth byte
+      kCarry = kTooShort | kTooLong | kTwoConts,
+    };
+
+    __attribute__((target("avx2")))
+    static __m256i lookup(const uint8_t (&_table)[16], const __m256i _index) {
+      const __m256i kTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(_table)));
+      return _mm256_shuffle_epi8(kTable, _index);
+    }
+
+    /**
+     * Method for shifting block by _shift bytes, so that the previous block fills the freed bytes
+     */
+    template <int _shift>
+    __attribute__((target("avx2")))
+    static __m256i getPrevious(const __m256i _block, const __m256i _prevBlock) {
+      return _mm256_alignr_epi8(_block, _mm256_permute2x128_si256(_prevBlock, _block, 0x21), 16 - _shift);
+    }
+
+    /**
+     * Method for checking block that is continuation of previous block
+     * @return Non-zero bytes at positions of errors
+     */
+    __attribute__((target("avx2")))
+    static __m256i checkBlockAvx2(const __m256i _block, const __m256i _prevBlock) {
+      static const uint8_t kByte1High[16] = {
+          kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+          kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+          kTooShort | kOverlong2,
+          kTooShort,
+          kTooShort | kOverlong3 | kSurrogate,
+          kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+      };
+      static const uint8_t kByte1Low[16] = {
+          kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+          kCarry | kOverlong2,
+          kCarry,
+          kCarry,
+          kCarry | kTooLarge,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+          kCarry | kTooLarge | kTooLarge1000,
+          kCarry | kTooLarge | kTooLarge1000,
+      };
+      static const uint8_t kByte2High[16] = {
+          kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+          kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+          kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+          kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+          kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+          kTooShort, kTooShort, kTooShort, kTooShort,
+      };
+      const __m256i kLowNibble = _mm256_set1_epi8(0x0F);
+      const __m256i kPrev1 = getPrevious<1>(_block, _prevBlock);
+      const __m256i kSpecialCases = _mm256_and_si256(
+          _mm256_and_si256(lookup(kByte1High, _mm256_and_si256(_mm256_srli_epi16(kPrev1, 4), kLowNibble)),
+                           lookup(kByte1Low, _mm256_and_si256(kPrev1, kLowNibble))),
+          lookup(kByte2High, _mm256_and_si256(_mm256_srli_epi16(_block, 4), kLowNibble)));
+      // Bytes after lead of 3 or 4 byte sequence at distance 2 or 3 should be continuations
+      const __m256i kIsThird = _mm256_subs_epu8(getPrevious<2>(_block, _prevBlock),
+                                                _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+      const __m256i kIsFourth = _mm256_subs_epu8(getPrevious<3>(_block, _prevBlock),
+                                                 _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+      const __m256i kMustBeContinuation = _mm256_and_si256(_mm256_or_si256(kIsThird, kIsFourth),
+                                                           _mm256_set1_epi8(static_cast<char>(0x80)));
+      return _mm256_xor_si256(kMustBeContinuation, kSpecialCases);
+    }
+
+    /**
+     * Method for validating data by blocks of 32 bytes.
+     * In block with terminating null character bytes after it are replaced by zeros.
+     * Block that contains error is left to scalar decoder
+     * @return Size of validated data, or length of string if terminating null character is found
+     */
+    __attribute__((target("avx2")))
+    static size_t validateAvx2(uint8_t const * _pData, const size_t _size, const bool _stopAtNull) {
+      // Lead bytes that need more bytes than left in block: 0xC0 and above at the last position,
+      // 0xE0 and above at the second from the end, 0xF0 and above at the third from the end
+      static const uint8_t kMaxComplete[32] = {
+          0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+          0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+      };
+      const __m256i kMaxCompleteBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(kMaxComplete));
+      const __m256i kZero = _mm256_setzero_si256();
+      const __m256i kPositions = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                  16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+      __m256i prevBlock = kZero;
+      __m256i prevIncomplete = kZero;
+      size_t i = 0;
+      while (_size - i >= 32 && !(_stopAtNull && isCrossingPage(_pData + i, 32))) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_pData + i));
+        const int kNullMask = _stopAtNull ? _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, kZero)) : 0;
+        if (kNullMask != 0) {
+          const int kNullPos = __builtin_ctz(static_cast<unsigned>(kNullMask));
+          block = _mm256_and_si256(block, _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(kNullPos)), kPositions));
+        }
+        if (_mm256_movemask_epi8(block) == 0) {
+          if (!_mm256_testz_si256(prevIncomplete, prevIncomplete)) {
+            break;
+          }
+        } else {
+          const __m256i kErrors = checkBlockAvx2(block, prevBlock);
+          if (!_mm256_testz_si256(kErrors, kErrors)) {
+            break;
+          }
+          prevIncomplete = _mm256_subs_epu8(block, kMaxCompleteBlock);
+        }
+        if (kNullMask != 0) {
+          return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(kNullMask)));
+        }
+        prevBlock = block;
+        i += 32;
+      }
+      return getCharBoundary(_pData, i);
+    }
+
+    /**
+     * Method for skipping ASCII characters by blocks of 16 bytes
+     * @return Number of skipped characters
+     */
+    __attribute__((target("sse2")))
+    static size_t skipAsciiSse2(uint8_t const * _pData, const size_t _size, const bool _stopAtNull) {
+      const __m128i kZero = _mm_setzero_si128();
+      size_t i = 0;
+      while (_size - i >= 16 && !(_stopAtNull && isCrossingPage(_pData + i, 16))) {
+        const __m128i kChunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_pData + i));
+        int mask = _mm_movemask_epi8(kChunk);
+        if (_stopAtNull) {
+          mask |= _mm_movemask_epi8(_mm_cmpeq_epi8(kChunk, kZero));
+        }
+        if (mask != 0) {
+          return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+        i += 16;
+      }
+      return i;
+    }
+#endif
+  };
+}
+
+#endif //BUFFERS_UTF8_HPP
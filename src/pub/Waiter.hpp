@@ -0,0 +1,94 @@
+/**
+ * @file Waiter.hpp
+ * @author Denis Kotov
+ * @date 18 Oct 2026
+ * @brief Contains waiting of condition with bounded spinning followed by blocking
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_WAITER_HPP
+#define BUFFERS_WAITER_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace buffers {
+  /**
+   * Waiting of condition changed by other threads without lock.
+   * Waiting thread checks condition a few times yielding in between, so short waits
+   * do not pay for system calls, then it blocks on condition variable.
+   * Thread that changes condition calls notifyOne() or notifyAll(), which take
+   * the mutex only if some thread is blocked
+   */
+  class Waiter {
+   public:
+    /**
+     * Number of checks of condition before blocking
+     */
+    static constexpr size_t kNumSpins = 64;
+
+    Waiter()
+        : num_blocked_{0} {
+    }
+
+    Waiter(const Waiter&) = delete;
+    Waiter& operator=(const Waiter&) = delete;
+
+    /**
+     * Method for waiting until condition is true
+     * @param _ready Callable that checks condition, could be called several times
+     */
+    template <typename TReady>
+    void wait(TReady _ready) {
+      for (size_t i = 0; i < kNumSpins; ++i) {
+        if (_ready()) {
+          return;
+        }
+        std::this_thread::yield();
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      num_blocked_.fetch_add(1, std::memory_order_relaxed);
+      // Pairs with fence in notify, so either condition is seen here or blocked thread is seen there
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (!_ready()) {
+        condition_.wait(lock);
+      }
+      num_blocked_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Method for waking one blocked thread, should be called after condition is changed
+     */
+    void notifyOne() {
+      if (hasBlocked()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition_.notify_one();
+      }
+    }
+
+    /**
+     * Method for waking all blocked threads, should be called after condition is changed
+     */
+    void notifyAll() {
+      if (hasBlocked()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition_.notify_all();
+      }
+    }
+
+   private:
+    bool hasBlocked() const {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return num_blocked_.load(std::memory_order_relaxed) > 0;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::atomic<size_t> num_blocked_;
+  };
+}
+
+#endif //BUFFERS_WAITER_HPP
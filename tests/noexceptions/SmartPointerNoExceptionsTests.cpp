@@ -0,0 +1,34 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+
+struct SmartPointerNoExceptionsTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(1000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(SmartPointerNoExceptionsTest, TypeMismatchTest)
+{
+  auto value = std::make_shared<uint32_t>(7);
+  ASSERT_EQ(buffer->put(value), true);
+  ASSERT_EQ(buffer->put(value), true);
+  ASSERT_EQ(buffer->put<uint16_t>(3), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(*unbuffer.get<std::shared_ptr<uint32_t>>(), 7);
+  ASSERT_EQ(unbuffer.get<std::shared_ptr<float>>(), nullptr);
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 3);
+}
@@ -0,0 +1,43 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/StaticString.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::StaticString;
+
+struct Utf8NoExceptionsTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(1000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(Utf8NoExceptionsTest, FieldAfterInvalidStringTest)
+{
+  ASSERT_EQ(buffer->put(std::string("bad \xC3( string")), true);
+  ASSERT_EQ(buffer->put<uint32_t>(42), true);
+  ASSERT_EQ(buffer->put("bad \xE2\x82 string"), true);
+  ASSERT_EQ(buffer->put<uint16_t>(7), true);
+  ASSERT_EQ(buffer->put(std::string("\xF0\x9F\x98 static")), true);
+  ASSERT_EQ(buffer->put(std::string("end")), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  unbuffer.setUtf8Validation(true);
+  ASSERT_EQ(unbuffer.get<std::string>(), "");
+  ASSERT_EQ(unbuffer.get<uint32_t>(), 42);
+  ASSERT_EQ(unbuffer.get<const char *>(), nullptr);
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 7);
+  ASSERT_EQ(unbuffer.get<StaticString<32>>() == "", true);
+  ASSERT_EQ(unbuffer.get<std::string>(), "end");
+  ASSERT_EQ(unbuffer.getBufferSize(), 0);
+}
@@ -0,0 +1,95 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/ArrayView.hpp"
+
+using buffers::AlignMemory;
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::ArrayView;
+
+struct ArrayViewTest : testing::Test
+{
+  uint8_t array[4096];
+  PackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new PackBuffer(array, sizeof(array));
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(ArrayViewTest, UnalignedArrayTest)
+{
+  std::vector<float> vec0 = {0.5f, 1.5f, 2.5f};
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  ASSERT_EQ(buffer->put(vec0), true);
+  ASSERT_EQ(buffer->getDataSize(), 4 + 8 + 3 * sizeof(float));
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 1);
+  auto view = unbuffer.get<ArrayView<float>>();
+  ASSERT_EQ(view.size(), vec0.size());
+  ASSERT_EQ(view[1], 1.5f);
+  ASSERT_EQ(view.toVector(), vec0);
+  ASSERT_EQ(unbuffer.getBufferSize(), 0);
+}
+
+TEST_F(ArrayViewTest, AlignedArrayTest)
+{
+  std::vector<float> small = {1.0f, 2.0f};
+  std::vector<float> large(100);
+  for (size_t i = 0; i < large.size(); ++i) {
+    large[i] = i * 0.25f;
+  }
+  ASSERT_EQ(buffer->setArrayAlignment(3, 64), false);
+  ASSERT_EQ(buffer->setArrayAlignment(64, 64), true);
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  ASSERT_EQ(buffer->put(small), true);
+  ASSERT_EQ(buffer->put(large), true);
+  ASSERT_EQ(buffer->put(large.data(), large.size()), true);
+  ASSERT_EQ(buffer->put<uint16_t>(7), true);
+
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 1);
+  auto smallView = unbuffer.get<ArrayView<float>>();
+  ASSERT_EQ(smallView.toVector(), small);
+  auto largeView = unbuffer.get<ArrayView<float>>();
+  ASSERT_EQ((reinterpret_cast<uint8_t const *>(largeView.data()) - buffer->getData()) % 64, 0);
+  ASSERT_EQ(largeView.size(), large.size());
+  for (size_t i = 0; i < large.size(); ++i) {
+    ASSERT_EQ(largeView.data()[i], large[i]);
+  }
+  ASSERT_EQ(unbuffer.get<std::vector<float>>(), large);
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 7);
+}
+
+TEST_F(ArrayViewTest, NaturalAlignedArrayTest)
+{
+  HeapPackBuffer packBuffer(4096, AlignMemory::Natural);
+  std::vector<double> large(20, 3.5);
+  ASSERT_EQ(packBuffer.setArrayAlignment(32, 128), true);
+  ASSERT_EQ(packBuffer.put<uint8_t>(1), true);
+  ASSERT_EQ(packBuffer.put(large), true);
+  UnpackBuffer unbuffer(packBuffer.getData(), packBuffer.getDataSize(), AlignMemory::Natural);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 1);
+  auto view = unbuffer.get<ArrayView<double>>();
+  ASSERT_EQ((reinterpret_cast<uint8_t const *>(view.data()) - packBuffer.getData()) % 32, 0);
+  ASSERT_EQ(view.toVector(), large);
+}
+
+TEST_F(ArrayViewTest, OverflowTest)
+{
+  HeapPackBuffer packBuffer(100);
+  std::vector<uint8_t> large(60, 1);
+  ASSERT_EQ(packBuffer.setArrayAlignment(64, 32), true);
+  ASSERT_EQ(packBuffer.put<uint32_t>(1), true);
+  ASSERT_EQ(packBuffer.put(large), false);
+  ASSERT_EQ(packBuffer.getDataSize(), 4);
+}
@@ -0,0 +1,113 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "pub/BoundedQueue.hpp"
+
+using buffers::BoundedQueue;
+
+struct BoundedQueueTest : testing::Test
+{
+  BoundedQueue<size_t> * queue;
+  virtual void SetUp() {
+    queue = new BoundedQueue<size_t>(5);
+  };
+
+  virtual void TearDown() {
+    delete queue;
+  };
+};
+
+TEST_F(BoundedQueueTest, FullEmptyTest)
+{
+  ASSERT_EQ(queue->capacity(), 8);
+  size_t value;
+  ASSERT_EQ(queue->tryPop(value), false);
+  for (size_t i = 0; i < queue->capacity(); ++i) {
+    ASSERT_EQ(queue->tryPush(i), true);
+  }
+  ASSERT_EQ(queue->tryPush(100), false);
+  for (size_t i = 0; i < queue->capacity(); ++i) {
+    ASSERT_EQ(queue->tryPop(value), true);
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_EQ(queue->tryPop(value), false);
+}
+
+TEST_F(BoundedQueueTest, MultiThreadTest)
+{
+  const size_t kNumValues = 10000;
+  std::atomic<size_t> sum{0};
+  std::atomic<size_t> numPopped{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 2; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = t; i < kNumValues; i += 2) {
+        queue->push(i);
+      }
+    });
+    threads.emplace_back([&]() {
+      size_t value;
+      while (numPopped.load() < kNumValues) {
+        if (queue->tryPop(value)) {
+          sum.fetch_add(value);
+          numPopped.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(sum.load(), kNumValues * (kNumValues - 1) / 2);
+}
+
+TEST_F(BoundedQueueTest, BlockingPopTest)
+{
+  std::vector<size_t> popped;
+  std::thread consumer([this, &popped]() {
+    size_t value;
+    while (queue->pop(value)) {
+      popped.push_back(value);
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  for (size_t i = 0; i < 20; ++i) {
+    queue->push(i);
+  }
+  queue->close();
+  consumer.join();
+  ASSERT_EQ(popped.size(), 20);
+  for (size_t i = 0; i < popped.size(); ++i) {
+    ASSERT_EQ(popped[i], i);
+  }
+  size_t value;
+  ASSERT_EQ(queue->pop(value), false);
+  queue->open();
+  ASSERT_EQ(queue->tryPush(1), true);
+  ASSERT_EQ(queue->pop(value), true);
+  ASSERT_EQ(value, 1);
+}
+
+TEST_F(BoundedQueueTest, BlockingPushTest)
+{
+  for (size_t i = 0; i < queue->capacity(); ++i) {
+    ASSERT_EQ(queue->tryPush(i), true);
+  }
+  std::atomic<bool> pushed{false};
+  std::thread producer([this, &pushed]() {
+    queue->push(100);
+    pushed.store(true);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(pushed.load(), false);
+  size_t value;
+  ASSERT_EQ(queue->pop(value), true);
+  ASSERT_EQ(value, 0);
+  producer.join();
+  ASSERT_EQ(pushed.load(), true);
+}
@@ -0,0 +1,155 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <thread>
+#include "pub/BufferPool.hpp"
+#include "pub/NumaTopology.hpp"
+
+using buffers::BufferPool;
+using buffers::HeapPackBuffer;
+using buffers::NumaTopology;
+
+struct BufferPoolTest : testing::Test
+{
+  BufferPool * pool;
+  std::vector<std::string> node_files;
+  std::vector<std::string> node_dirs;
+  virtual void SetUp() {
+    pool = new BufferPool(128);
+  };
+
+  virtual void TearDown() {
+    delete pool;
+    for (auto & file : node_files) {
+      unlink(file.c_str());
+    }
+    for (auto it = node_dirs.rbegin(); it != node_dirs.rend(); ++it) {
+      rmdir(it->c_str());
+    }
+  };
+
+  /**
+   * Creates directory in format of /sys/devices/system/node
+   */
+  std::string createNodes(const std::string & _online,
+                          const std::vector<std::pair<size_t, std::string>> & _cpuLists) {
+    char path[] = "/tmp/BufferPoolTestXXXXXX";
+    const std::string kRoot = mkdtemp(path);
+    node_dirs.push_back(kRoot);
+    node_files.push_back(kRoot + "/online");
+    std::ofstream(node_files.back()) << _online << "\n";
+    for (auto & cpuList : _cpuLists) {
+      node_dirs.push_back(kRoot + "/node" + std::to_string(cpuList.first));
+      mkdir(node_dirs.back().c_str(), 0700);
+      node_files.push_back(node_dirs.back() + "/cpulist");
+      std::ofstream(node_files.back()) << cpuList.second << "\n";
+    }
+    return kRoot;
+  }
+};
+
+TEST_F(BufferPoolTest, ReuseTest)
+{
+  HeapPackBuffer * buffer0 = pool->acquire();
+  ASSERT_EQ(buffer0->put<uint32_t>(5), true);
+  pool->release(buffer0);
+  HeapPackBuffer * buffer1 = pool->acquire();
+  ASSERT_EQ(buffer1, buffer0);
+  ASSERT_EQ(buffer1->getDataSize(), 0);
+  ASSERT_EQ(pool->getNumBuffers(), 1);
+  pool->release(buffer1);
+}
+
+TEST_F(BufferPoolTest, ShardsTest)
+{
+  ASSERT_GE(NumaTopology::get().getNumNodes(), 1);
+  ASSERT_LT(NumaTopology::get().getCurrentNode(), NumaTopology::get().getNumNodes());
+  ASSERT_EQ(pool->getNumShards(), NumaTopology::get().getNumNodes());
+  BufferPool singlePool(128, buffers::AlignMemory::Bits_32, false);
+  ASSERT_EQ(singlePool.getNumShards(), 1);
+}
+
+TEST_F(BufferPoolTest, MultiThreadTest)
+{
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([this]() {
+      for (size_t i = 0; i < 100; ++i) {
+        HeapPackBuffer * buffer = pool->acquire();
+        buffer->put(i);
+        pool->release(buffer);
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  ASSERT_LE(pool->getNumBuffers(), 4 * pool->getNumShards());
+  if (pool->getNumShards() == 1) {
+    ASSERT_EQ(pool->getNumCrossNodeReleases(), 0);
+  }
+}
+
+TEST_F(BufferPoolTest, SparseNodesTest)
+{
+  const NumaTopology kTopology(createNodes("0,2-3", {{0, "0-1"}, {2, "2"}, {3, "3,5"}}));
+  ASSERT_EQ(kTopology.getNumNodes(), 3);
+  ASSERT_LT(kTopology.getCurrentNode(), kTopology.getNumNodes());
+  BufferPool sparsePool(128, buffers::AlignMemory::Bits_32, true, kTopology);
+  ASSERT_EQ(sparsePool.getNumShards(), 3);
+  const NumaTopology kMissingTopology(createNodes("", {}) + "/missing");
+  ASSERT_EQ(kMissingTopology.getNumNodes(), 1);
+}
+
+#ifdef __linux__
+static void pinToCpu(const size_t _cpu) {
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(_cpu, &cpus);
+  sched_setaffinity(0, sizeof(cpus), &cpus);
+}
+
+TEST_F(BufferPoolTest, CrossNodeTest)
+{
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  std::vector<size_t> cpus;
+  for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      cpus.push_back(cpu);
+    }
+  }
+  ASSERT_GE(cpus.size(), 1);
+  std::string otherCpus;
+  for (size_t i = 1; i < cpus.size(); ++i) {
+    otherCpus += (i > 1 ? "," : "") + std::to_string(cpus[i]);
+  }
+  const NumaTopology kTopology(createNodes("0-1", {{0, std::to_string(cpus[0])}, {1, otherCpus}}));
+  ASSERT_EQ(kTopology.getNumNodes(), 2);
+  BufferPool numaPool(128, buffers::AlignMemory::Bits_32, true, kTopology);
+  ASSERT_EQ(numaPool.getNumShards(), 2);
+  std::thread([&numaPool, &cpus]() {
+    pinToCpu(cpus[0]);
+    HeapPackBuffer * buffer = numaPool.acquire();
+    numaPool.release(buffer);
+    ASSERT_EQ(numaPool.getNumCrossNodeReleases(), 0);
+    if (cpus.size() < 2) {
+      return;
+    }
+    buffer = numaPool.acquire();
+    pinToCpu(cpus[1]);
+    numaPool.release(buffer);
+    ASSERT_EQ(numaPool.getNumCrossNodeReleases(), 1);
+    pinToCpu(cpus[0]);
+    ASSERT_EQ(numaPool.acquire(), buffer);
+    ASSERT_EQ(numaPool.getNumBuffers(), 1);
+  }).join();
+}
+#endif
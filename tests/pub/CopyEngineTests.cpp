@@ -0,0 +1,80 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/CopyEngine.hpp"
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+
+using buffers::CopyEngine;
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+
+struct CopyEngineTest : testing::Test
+{
+  virtual void SetUp() {
+    CopyEngine::setStreamingThreshold(64);
+  };
+
+  virtual void TearDown() {
+    CopyEngine::setStreamingThreshold(0);
+  };
+};
+
+TEST_F(CopyEngineTest, StreamingCopyTest)
+{
+  std::vector<uint8_t> src(1000);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint8_t>(i * 7);
+  }
+  for (size_t offset = 0; offset < 17; ++offset) {
+    for (size_t size : {0, 10, 63, 64, 65, 200, 983}) {
+      std::vector<uint8_t> dst(1000, 0);
+      CopyEngine::copy(dst.data() + offset, src.data() + (16 - offset), size);
+      ASSERT_EQ(std::equal(dst.begin() + offset, dst.begin() + offset + size, src.begin() + (16 - offset)), true);
+      ASSERT_EQ(std::count(dst.begin() + offset + size, dst.end(), 0), dst.end() - dst.begin() - offset - size);
+    }
+  }
+}
+
+TEST_F(CopyEngineTest, VectorTest)
+{
+  HeapPackBuffer buffer(50000);
+  std::vector<double> vec0(5000);
+  for (size_t i = 0; i < vec0.size(); ++i) {
+    vec0[i] = i * 0.25;
+  }
+  std::vector<uint8_t> vec1 = {1, 2, 3, 4, 5};
+  ASSERT_EQ(buffer.put(vec0), true);
+  ASSERT_EQ(buffer.put(vec1), true);
+  ASSERT_EQ(buffer.put<uint16_t>(7), true);
+  UnpackBuffer unbuffer(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unbuffer.get<std::vector<double>>(), vec0);
+  ASSERT_EQ(unbuffer.get<std::vector<uint8_t>>(), vec1);
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 7);
+}
+
+TEST_F(CopyEngineTest, GatherScatterTest)
+{
+  std::vector<uint8_t> src(2000);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint8_t>(i * 13 + 1);
+  }
+  for (size_t elemSize : {1, 2, 3, 4, 8, 12}) {
+    for (size_t stride : {elemSize, elemSize + 1, size_t{16}, size_t{24}}) {
+      for (size_t count : {0, 1, 7, 9, 33}) {
+        std::vector<uint8_t> dst(count * elemSize);
+        CopyEngine::gather(dst.data(), src.data() + 1, count, stride, elemSize);
+        std::vector<uint8_t> back(2000, 0);
+        CopyEngine::scatter(back.data() + 1, stride, dst.data(), count, elemSize);
+        for (size_t i = 0; i < count; ++i) {
+          ASSERT_EQ(std::equal(dst.begin() + i * elemSize, dst.begin() + (i + 1) * elemSize,
+                               src.begin() + 1 + i * stride), true);
+          ASSERT_EQ(std::equal(back.begin() + 1 + i * stride, back.begin() + 1 + i * stride + elemSize,
+                               src.begin() + 1 + i * stride), true);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,76 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/DecodedCache.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::DecodedCache;
+
+struct DecodedCacheTest : testing::Test
+{
+  DecodedCache<std::map<std::string, int32_t>> * cache;
+  virtual void SetUp() {
+    cache = new DecodedCache<std::map<std::string, int32_t>>(2);
+  };
+
+  virtual void TearDown() {
+    delete cache;
+  };
+};
+
+TEST_F(DecodedCacheTest, HitTest)
+{
+  std::map<std::string, int32_t> map0 = {{"one", 1}, {"two", 2}};
+  HeapPackBuffer buffer(1000);
+  ASSERT_EQ(buffer.put(map0), true);
+  auto map1 = cache->get(buffer.getData(), buffer.getDataSize());
+  auto map2 = cache->get(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(*map1, map0);
+  ASSERT_EQ(map1, map2);
+  ASSERT_EQ(cache->getNumHits(), 1);
+  ASSERT_EQ(cache->getNumMisses(), 1);
+  ASSERT_EQ(cache->getSize(), 1);
+}
+
+TEST_F(DecodedCacheTest, DifferentMessagesTest)
+{
+  std::map<std::string, int32_t> map0 = {{"one", 1}};
+  std::map<std::string, int32_t> map1 = {{"one", 2}};
+  HeapPackBuffer buffer0(1000);
+  HeapPackBuffer buffer1(1000);
+  ASSERT_EQ(buffer0.put(map0), true);
+  ASSERT_EQ(buffer1.put(map1), true);
+  ASSERT_EQ(*cache->get(buffer0.getData(), buffer0.getDataSize()), map0);
+  ASSERT_EQ(*cache->get(buffer1.getData(), buffer1.getDataSize()), map1);
+  ASSERT_EQ(cache->getNumMisses(), 2);
+  ASSERT_EQ(cache->getSize(), 2);
+}
+
+TEST_F(DecodedCacheTest, EvictionTest)
+{
+  HeapPackBuffer buffer0(1000);
+  HeapPackBuffer buffer1(1000);
+  HeapPackBuffer buffer2(1000);
+  HeapPackBuffer * buffers[3] = {&buffer0, &buffer1, &buffer2};
+  for (int32_t i = 0; i < 3; ++i) {
+    std::map<std::string, int32_t> map0 = {{"key", i}};
+    ASSERT_EQ(buffers[i]->put(map0), true);
+  }
+  auto map0 = cache->get(buffers[0]->getData(), buffers[0]->getDataSize());
+  cache->get(buffers[1]->getData(), buffers[1]->getDataSize());
+  cache->get(buffers[0]->getData(), buffers[0]->getDataSize());
+  cache->get(buffers[2]->getData(), buffers[2]->getDataSize());
+  ASSERT_EQ(cache->getSize(), 2);
+  ASSERT_EQ(cache->getNumHits(), 1);
+  // buffers[1] is least recently used and evicted
+  cache->get(buffers[0]->getData(), buffers[0]->getDataSize());
+  ASSERT_EQ(cache->getNumHits(), 2);
+  cache->get(buffers[1]->getData(), buffers[1]->getDataSize());
+  ASSERT_EQ(cache->getNumMisses(), 4);
+  cache->clear();
+  ASSERT_EQ(cache->getSize(), 0);
+  ASSERT_EQ(map0->at("key"), 0);
+}
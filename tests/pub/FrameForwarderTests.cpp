@@ -0,0 +1,136 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#if defined(__linux__)
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/MessageScanner.hpp"
+#include "pub/FrameForwarder.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::MessageScanner;
+using buffers::FrameForwarder;
+
+struct FrameForwarderTest : testing::Test
+{
+  HeapPackBuffer * batch;
+  int file_fd;
+  int sockets[2];
+  virtual void SetUp() {
+    batch = new HeapPackBuffer(10000);
+    for (uint32_t i = 0; i < 20; ++i) {
+      HeapPackBuffer message(100);
+      message.put(i);
+      message.put("message" + std::to_string(i));
+      batch->put(message.getData(), message.getDataSize());
+    }
+    char path[] = "/tmp/FrameForwarderTestXXXXXX";
+    file_fd = mkstemp(path);
+    unlink(path);
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+  };
+
+  virtual void TearDown() {
+    close(sockets[0]);
+    close(sockets[1]);
+    close(file_fd);
+    delete batch;
+  };
+
+  std::vector<uint8_t> receive(const size_t _size) {
+    std::vector<uint8_t> result(_size);
+    size_t received = 0;
+    while (received < _size) {
+      const ssize_t kRead = read(sockets[1], result.data() + received, _size - received);
+      if (kRead <= 0) {
+        break;
+      }
+      received += static_cast<size_t>(kRead);
+    }
+    result.resize(received);
+    return result;
+  }
+};
+
+TEST_F(FrameForwarderTest, ForwardAllTest)
+{
+  ASSERT_EQ(write(file_fd, batch->getData(), batch->getDataSize()),
+            static_cast<ssize_t>(batch->getDataSize()));
+  FrameForwarder forwarder(file_fd, sockets[0]);
+  ASSERT_EQ(forwarder.forward(), 20);
+  ASSERT_EQ(forwarder.getOffset(), static_cast<off_t>(batch->getDataSize()));
+  auto received = receive(batch->getDataSize());
+  ASSERT_EQ(received, std::vector<uint8_t>(batch->getData(), batch->getData() + batch->getDataSize()));
+  MessageScanner scanner(received.data(), received.size());
+  uint32_t expectedId = 0;
+  ASSERT_EQ(scanner.scan([&expectedId](UnpackBuffer & _msg) {
+    ASSERT_EQ(_msg.get<uint32_t>(), expectedId++);
+  }), 20);
+}
+
+TEST_F(FrameForwarderTest, ForwardPartTest)
+{
+  ASSERT_EQ(write(file_fd, batch->getData(), batch->getDataSize()),
+            static_cast<ssize_t>(batch->getDataSize()));
+  FrameForwarder forwarder(file_fd, sockets[0]);
+  ASSERT_EQ(forwarder.forward(5), 5);
+  ASSERT_EQ(forwarder.forward(5), 5);
+  ASSERT_EQ(forwarder.getForwardedFrames(), 10);
+  auto received = receive(static_cast<size_t>(forwarder.getOffset()));
+  MessageScanner scanner(received.data(), received.size());
+  ASSERT_EQ(scanner.scan([](UnpackBuffer &) {}), 10);
+}
+
+TEST_F(FrameForwarderTest, IncompleteFrameTest)
+{
+  ASSERT_EQ(write(file_fd, batch->getData(), batch->getDataSize() - 3),
+            static_cast<ssize_t>(batch->getDataSize() - 3));
+  FrameForwarder forwarder(file_fd, sockets[0]);
+  ASSERT_EQ(forwarder.forward(), 19);
+  ASSERT_EQ(forwarder.forward(), 0);
+}
+
+TEST_F(FrameForwarderTest, PartialFrameTest)
+{
+  ASSERT_EQ(write(file_fd, batch->getData(), batch->getDataSize()),
+            static_cast<ssize_t>(batch->getDataSize()));
+  char path[] = "/tmp/FrameForwarderOutXXXXXX";
+  const int kOutFd = mkstemp(path);
+  unlink(path);
+  // Output file is limited to the middle of the 6th frame, so sending fails in the middle of frame
+  size_t limit = 0;
+  MessageScanner frames(batch->getData(), batch->getDataSize());
+  size_t frameIdx = 0;
+  frames.scan([&](UnpackBuffer & _msg) {
+    if (frameIdx++ == 5) {
+      limit = static_cast<size_t>(_msg.getData() - batch->getData());
+    }
+  });
+  auto previousHandler = signal(SIGXFSZ, SIG_IGN);
+  struct rlimit previousLimit;
+  getrlimit(RLIMIT_FSIZE, &previousLimit);
+  struct rlimit newLimit = previousLimit;
+  newLimit.rlim_cur = limit;
+  setrlimit(RLIMIT_FSIZE, &newLimit);
+  FrameForwarder forwarder(file_fd, kOutFd);
+  const size_t kNumForwarded = forwarder.forward();
+  setrlimit(RLIMIT_FSIZE, &previousLimit);
+  signal(SIGXFSZ, previousHandler);
+
+  ASSERT_EQ(kNumForwarded, 5);
+  ASSERT_GT(forwarder.getPartialBytes(), 0);
+  ASSERT_EQ(static_cast<size_t>(forwarder.getOffset()) + forwarder.getPartialBytes(), limit);
+  ASSERT_EQ(forwarder.forward(), 15);
+  ASSERT_EQ(forwarder.getPartialBytes(), 0);
+  ASSERT_EQ(forwarder.getForwardedFrames(), 20);
+  std::vector<uint8_t> output(batch->getDataSize());
+  ASSERT_EQ(pread(kOutFd, output.data(), output.size(), 0), static_cast<ssize_t>(output.size()));
+  ASSERT_EQ(output, std::vector<uint8_t>(batch->getData(), batch->getData() + batch->getDataSize()));
+  close(kOutFd);
+}
+#endif
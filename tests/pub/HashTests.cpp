@@ -0,0 +1,123 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/Hash.hpp"
+
+using buffers::AlignMemory;
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::Hash64;
+using buffers::Hash128;
+
+struct HashTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(10000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(HashTest, KnownValuesTest)
+{
+  const uint8_t kData[] = {'a', 'b', 'c'};
+  ASSERT_EQ(Hash64::hash(kData, 0), 0xEF46DB3751D8E999ULL);
+  ASSERT_EQ(Hash64::hash(kData, sizeof(kData)), 0x44BC2CF5AD770999ULL);
+}
+
+TEST_F(HashTest, StreamingTest)
+{
+  uint8_t data[1000];
+  for (size_t i = 0; i < sizeof(data); ++i) {
+    data[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  Hash64 hash(42);
+  size_t offset = 0;
+  for (size_t piece = 1; offset < sizeof(data); ++piece) {
+    const size_t kSize = std::min(piece, sizeof(data) - offset);
+    hash.update(data + offset, kSize);
+    offset += kSize;
+  }
+  ASSERT_EQ(hash.digest(), Hash64::hash(data, sizeof(data), 42));
+  ASSERT_NE(hash.digest(), Hash64::hash(data, sizeof(data), 43));
+}
+
+TEST_F(HashTest, PackHashTest)
+{
+  buffer->enableHashing(7);
+  std::vector<int32_t> vec0 = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  ASSERT_EQ(buffer->put(vec0), true);
+  ASSERT_EQ(buffer->put("string"), true);
+  ASSERT_EQ(buffer->put<double>(2.5), true);
+  ASSERT_EQ(buffer->getHash(), Hash64::hash(buffer->getData(), buffer->getDataSize(), 7));
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.getHash(7), buffer->getHash());
+  ASSERT_EQ(unbuffer.getHash128(7), buffer->getHash128());
+}
+
+TEST_F(HashTest, ZeroedPaddingTest)
+{
+  ASSERT_EQ(buffer->put<uint64_t>(0xFFFFFFFFFFFFFFFFULL), true);
+  buffer->reset();
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  ASSERT_EQ(buffer->put<uint8_t>(2), true);
+  for (size_t i = 1; i < sizeof(int); ++i) {
+    ASSERT_EQ(buffer->getData()[i], 0);
+  }
+  HeapPackBuffer buffer1(10000);
+  ASSERT_EQ(buffer1.put<uint8_t>(1), true);
+  ASSERT_EQ(buffer1.put<uint8_t>(2), true);
+  ASSERT_EQ(buffer->getHash(), buffer1.getHash());
+  ASSERT_EQ(isEqualPacked(*buffer, buffer1), true);
+  ASSERT_EQ(buffer1.put<uint8_t>(3), true);
+  ASSERT_EQ(isEqualPacked(*buffer, buffer1), false);
+}
+
+TEST_F(HashTest, RollbackTest)
+{
+  buffer->enableHashing();
+  HeapPackBuffer smallBuffer(30);
+  smallBuffer.enableHashing();
+  std::vector<int32_t> vec0 = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  ASSERT_EQ(smallBuffer.put<uint32_t>(5), true);
+  ASSERT_EQ(smallBuffer.put(vec0), false);
+  ASSERT_EQ(smallBuffer.put<uint32_t>(6), true);
+  ASSERT_EQ(smallBuffer.getHash(), Hash64::hash(smallBuffer.getData(), smallBuffer.getDataSize()));
+  ASSERT_EQ(buffer->put<uint32_t>(5), true);
+  auto handle = buffer->putField<uint32_t>(0);
+  ASSERT_EQ(buffer->put<uint32_t>(7), true);
+  ASSERT_EQ(buffer->patch(handle, uint32_t{6}), true);
+  ASSERT_EQ(buffer->getHash(), Hash64::hash(buffer->getData(), buffer->getDataSize()));
+}
+
+TEST_F(HashTest, Hash128Test)
+{
+  const uint8_t kData[] = {'a', 'b', 'c'};
+  const Hash128 kHash = Hash64::hash128(kData, sizeof(kData));
+  ASSERT_EQ(kHash.low, Hash64::hash(kData, sizeof(kData)));
+  ASSERT_NE(kHash.low, kHash.high);
+  ASSERT_EQ(kHash, Hash64::hash128(kData, sizeof(kData)));
+  ASSERT_NE(kHash, Hash64::hash128(kData, sizeof(kData) - 1));
+}
+
+TEST_F(HashTest, UnsizedUnpackHashTest)
+{
+  ASSERT_EQ(buffer->put<uint32_t>(1), true);
+  ASSERT_EQ(buffer->put("string"), true);
+  UnpackBuffer unbuffer(buffer->getData());
+  ASSERT_EQ(unbuffer.getDataSize(), 0);
+  ASSERT_EQ(unbuffer.getHash(), Hash64::hash(buffer->getData(), 0));
+  ASSERT_EQ(unbuffer.get<uint32_t>(), 1);
+  ASSERT_EQ(unbuffer.get(), std::string("string"));
+  ASSERT_EQ(unbuffer.getDataSize(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.getHash(), buffer->getHash());
+}
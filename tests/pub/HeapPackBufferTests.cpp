@@ -57,6 +57,40 @@ struct HeapPackBufferMixedDataTest : testing::Test
   };
 };
 
+struct HeapPackBufferFieldTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(100);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+struct HeapPackBufferCanonicalTest : testing::Test
+{
+  HeapPackBuffer * buffer0;
+  HeapPackBuffer * buffer1;
+  virtual void SetUp() {
+    buffer0 = new HeapPackBuffer(100000);
+    buffer1 = new HeapPackBuffer(100000);
+    buffer0->setCanonical(true);
+    buffer1->setCanonical(true);
+  };
+
+  virtual void TearDown() {
+    delete buffer0;
+    delete buffer1;
+  };
+
+  bool isSamePacked() const {
+    return buffer0->getDataSize() == buffer1->getDataSize() &&
+           std::memcmp(buffer0->getData(), buffer1->getData(), buffer0->getDataSize()) == 0;
+  }
+};
+
 TEST_F(HeapPackBufferIntTest, ValidIntTest)
 {
   ASSERT_EQ(buffer->put(uint8_t{ 1 }), true);
@@ -512,3 +546,190 @@ TEST_F(HeapPackBufferMixedDataTest, MixedDataTest4)
   auto res1 = unbuffer.get<std::map<std::string, int>>();
   ASSERT_EQ(res1, map1);
 }
+
+TEST_F(HeapPackBufferFieldTest, PatchFieldTest)
+{
+  ASSERT_EQ(buffer->put("Hello"), true);
+  auto counter = buffer->putField<uint32_t>(5);
+  ASSERT_EQ(counter.isValid(), true);
+  ASSERT_EQ(buffer->put(std::vector<int>{1, 2, 3}), true);
+  auto ratio = buffer->putField<double>(0.5);
+  ASSERT_EQ(ratio.isValid(), true);
+  ASSERT_EQ(buffer->patch(counter, 42), true);
+  ASSERT_EQ(buffer->patch(ratio, 2.5), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get(), std::string{"Hello"});
+  ASSERT_EQ(unbuffer.get<uint32_t>(), 42);
+  ASSERT_EQ((unbuffer.get<std::vector<int>>()), (std::vector<int>{1, 2, 3}));
+  ASSERT_EQ(unbuffer.get<double>(), 2.5);
+}
+
+TEST_F(HeapPackBufferFieldTest, PatchCopyTest)
+{
+  auto counter = buffer->putField<uint16_t>(1);
+  ASSERT_EQ(buffer->put<uint8_t>(8), true);
+  std::vector<uint8_t> copy(buffer->getData(), buffer->getData() + buffer->getDataSize());
+  ASSERT_EQ(counter.patch(copy.data(), copy.size(), uint16_t{7}), true);
+  ASSERT_EQ(counter.read(copy.data()), 7);
+  ASSERT_EQ(counter.read(buffer->getData()), 1);
+  ASSERT_EQ(counter.patch(copy.data(), 1, uint16_t{7}), false);
+}
+
+TEST_F(HeapPackBufferFieldTest, InvalidFieldTest)
+{
+  HeapPackBuffer smallBuffer(4);
+  ASSERT_EQ(smallBuffer.putField<uint32_t>(1).isValid(), true);
+  auto field = smallBuffer.putField<uint32_t>(2);
+  ASSERT_EQ(field.isValid(), false);
+  ASSERT_EQ(smallBuffer.patch(field, uint32_t{3}), false);
+}
+
+TEST_F(HeapPackBufferVectorTest, OverflowMapTest)
+{
+  std::map<std::string, int> map0;
+  for (int i = 0; i < 40; ++i) {
+    map0[std::to_string(i)] = i;
+  }
+  ASSERT_EQ(buffer->put<uint8_t>(8), true);
+  const size_t kDataSize = buffer->getDataSize();
+  ASSERT_EQ(buffer->put(map0), false);
+  ASSERT_EQ(buffer->getDataSize(), kDataSize);
+  ASSERT_EQ(buffer->put(std::list<int>{1, 2}), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 8);
+  ASSERT_EQ(unbuffer.get<std::list<int>>(), (std::list<int>{1, 2}));
+}
+
+TEST_F(HeapPackBufferVectorTest, LargeMapTest)
+{
+  HeapPackBuffer largeBuffer(1000000);
+  std::map<int, std::string> map0;
+  std::unordered_set<uint64_t> set0;
+  for (int i = 0; i < 10000; ++i) {
+    map0[i] = std::to_string(i * 3);
+    set0.insert(static_cast<uint64_t>(i) * 7);
+  }
+  ASSERT_EQ(largeBuffer.put(map0), true);
+  ASSERT_EQ(largeBuffer.put(set0), true);
+  UnpackBuffer unbuffer(largeBuffer.getData(), largeBuffer.getDataSize());
+  ASSERT_EQ((unbuffer.get<std::map<int, std::string>>()), map0);
+  ASSERT_EQ(unbuffer.get<std::unordered_set<uint64_t>>(), set0);
+}
+
+TEST_F(HeapPackBufferCanonicalTest, IntegralKeysTest)
+{
+  std::unordered_map<int32_t, double> map0;
+  std::unordered_map<int32_t, double> map1(1000);
+  for (int32_t i = -500; i < 500; ++i) {
+    map0[i * 7919] = i * 0.5;
+  }
+  for (int32_t i = 499; i >= -500; --i) {
+    map1[i * 7919] = i * 0.5;
+  }
+  ASSERT_EQ(buffer0->put(map0), true);
+  ASSERT_EQ(buffer1->put(map1), true);
+  ASSERT_EQ(isSamePacked(), true);
+  UnpackBuffer unbuffer(buffer0->getData(), buffer0->getDataSize());
+  ASSERT_EQ((unbuffer.get<std::unordered_map<int32_t, double>>()), map0);
+  unbuffer.reset();
+  int32_t previous = std::numeric_limits<int32_t>::min();
+  for (size_t i = unbuffer.get<size_t>(); i > 0; --i) {
+    const int32_t kKey = unbuffer.get<int32_t>();
+    ASSERT_LT(previous, kKey);
+    previous = kKey;
+    unbuffer.skip<double>();
+  }
+}
+
+TEST_F(HeapPackBufferCanonicalTest, StringKeysTest)
+{
+  std::unordered_set<std::string> set0;
+  std::unordered_set<std::string> set1(500);
+  for (int i = 0; i < 100; ++i) {
+    set0.insert("key" + std::to_string(i));
+    set1.insert("key" + std::to_string(99 - i));
+  }
+  std::unordered_map<std::string, std::unordered_set<uint8_t>> map0 = {{"a", {1, 2, 3}}, {"b", {200, 100}}};
+  std::unordered_map<std::string, std::unordered_set<uint8_t>> map1 = {{"b", {100, 200}}, {"a", {3, 2, 1}}};
+  ASSERT_EQ(buffer0->put(set0), true);
+  ASSERT_EQ(buffer0->put(map0), true);
+  ASSERT_EQ(buffer1->put(set1), true);
+  ASSERT_EQ(buffer1->put(map1), true);
+  ASSERT_EQ(isSamePacked(), true);
+  UnpackBuffer unbuffer(buffer0->getData(), buffer0->getDataSize());
+  ASSERT_EQ(unbuffer.get<std::unordered_set<std::string>>(), set0);
+  ASSERT_EQ((unbuffer.get<std::unordered_map<std::string, std::unordered_set<uint8_t>>>()), map0);
+}
+
+TEST_F(HeapPackBufferVectorTest, GetIntoArrayTest)
+{
+  const int32_t kArray0[5] = {1, 2, 3, 4, 5};
+  ASSERT_EQ(buffer->getTypeSize(kArray0), sizeof(size_t) + sizeof(kArray0));
+  ASSERT_EQ(buffer->put(kArray0), true);
+  ASSERT_EQ(buffer->getDataSize(), sizeof(size_t) + sizeof(kArray0));
+  std::vector<int32_t> vec0 = {6, 7, 8};
+  ASSERT_EQ(buffer->put(vec0.data(), vec0.size()), true);
+  ASSERT_EQ(buffer->put(vec0), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  int32_t array1[5];
+  ASSERT_EQ(unbuffer.getInto(array1), 5);
+  ASSERT_EQ(std::equal(kArray0, kArray0 + 5, array1), true);
+  int32_t array2[10];
+  ASSERT_EQ(unbuffer.getInto(array2, 10), 3);
+  ASSERT_EQ(std::equal(vec0.begin(), vec0.end(), array2), true);
+  ASSERT_EQ(unbuffer.getInto(array2 + 3, 7), 3);
+  ASSERT_EQ(std::equal(vec0.begin(), vec0.end(), array2 + 3), true);
+  ASSERT_EQ(unbuffer.getBufferSize(), 0);
+}
+
+TEST_F(HeapPackBufferVectorTest, GetIntoOverflowTest)
+{
+  std::vector<int16_t> vec0 = {1, 2, 3, 4};
+  ASSERT_EQ(buffer->put(vec0), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  int16_t array1[3];
+  ASSERT_THROW(unbuffer.getInto(array1), std::length_error);
+}
+
+TEST_F(HeapPackBufferVectorTest, GetIntoTruncatedTest)
+{
+  std::vector<int16_t> vec0 = {1, 2, 3, 4};
+  ASSERT_EQ(buffer->put(vec0), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize() - 1);
+  int16_t array1[4];
+  ASSERT_THROW(unbuffer.getInto(array1), std::length_error);
+  UnpackBuffer stridedUnbuffer(buffer->getData(), buffer->getDataSize() - 1);
+  int16_t array2[4][2];
+  ASSERT_THROW(stridedUnbuffer.getStrided(&array2[0][1], 4, sizeof(array2[0])), std::length_error);
+}
+
+TEST_F(HeapPackBufferVectorTest, StridedTest)
+{
+  struct Point {
+    int32_t x;
+    double y;
+  };
+  const Point kPoints0[4] = {{1, 1.5}, {2, 2.5}, {3, 3.5}, {4, 4.5}};
+  ASSERT_EQ(buffer->putStrided(&kPoints0[0].y, 4, sizeof(Point)), true);
+  HeapPackBuffer expected(200);
+  std::vector<double> vec0 = {1.5, 2.5, 3.5, 4.5};
+  ASSERT_EQ(expected.put(vec0), true);
+  ASSERT_EQ(isEqualPacked(*buffer, expected), true);
+
+  const int32_t kMatrix0[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+  ASSERT_EQ(buffer->putStrided(&kMatrix0[0][1], 3, sizeof(kMatrix0[0])), true);
+
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  Point points1[4] = {};
+  ASSERT_EQ(unbuffer.getStrided(&points1[0].y, 4, sizeof(Point)), 4);
+  int32_t matrix1[3][3] = {};
+  ASSERT_EQ(unbuffer.getStrided(&matrix1[0][2], 3, sizeof(matrix1[0])), 3);
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(points1[i].x, 0);
+    ASSERT_EQ(points1[i].y, kPoints0[i].y);
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(matrix1[i][0], 0);
+    ASSERT_EQ(matrix1[i][2], kMatrix0[i][1]);
+  }
+}
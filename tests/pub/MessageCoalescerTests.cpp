@@ -0,0 +1,172 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <thread>
+#include "pub/MessageScanner.hpp"
+#include "pub/MessageCoalescer.hpp"
+
+using buffers::BufferPool;
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::MessageScanner;
+using buffers::MessageCoalescer;
+
+struct MessageCoalescerTest : testing::Test
+{
+  BufferPool * pool;
+  int sockets[2];
+  virtual void SetUp() {
+    pool = new BufferPool(100);
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+  };
+
+  virtual void TearDown() {
+    close(sockets[0]);
+    close(sockets[1]);
+    delete pool;
+  };
+
+  std::vector<uint8_t> receiveAll() {
+    shutdown(sockets[0], SHUT_WR);
+    std::vector<uint8_t> result;
+    uint8_t chunk[1024];
+    ssize_t numRead;
+    while ((numRead = read(sockets[1], chunk, sizeof(chunk))) > 0) {
+      result.insert(result.end(), chunk, chunk + numRead);
+    }
+    return result;
+  }
+};
+
+TEST_F(MessageCoalescerTest, MessageLimitTest)
+{
+  {
+    MessageCoalescer coalescer(sockets[0], *pool, 100000, 4, std::chrono::seconds(10));
+    for (uint32_t i = 0; i < 10; ++i) {
+      HeapPackBuffer * message = coalescer.acquire();
+      ASSERT_EQ(message->put(i), true);
+      ASSERT_EQ(message->put("message"), true);
+      ASSERT_EQ(coalescer.submit(message), true);
+    }
+    ASSERT_EQ(coalescer.getNumFlushes(), 2);
+    ASSERT_EQ(coalescer.getNumPending(), 2);
+    ASSERT_EQ(coalescer.flush(), true);
+    ASSERT_EQ(coalescer.getBatchHistogram()[1], 1);
+    ASSERT_EQ(coalescer.getBatchHistogram()[2], 2);
+    ASSERT_EQ(pool->getNumBuffers(), 4);
+  }
+  auto received = receiveAll();
+  MessageScanner scanner(received.data(), received.size());
+  uint32_t expectedId = 0;
+  ASSERT_EQ(scanner.scan([&expectedId](UnpackBuffer & _msg) {
+    ASSERT_EQ(_msg.get<uint32_t>(), expectedId++);
+    ASSERT_EQ(_msg.get(), std::string{"message"});
+  }), 10);
+}
+
+TEST_F(MessageCoalescerTest, ByteLimitTest)
+{
+  MessageCoalescer coalescer(sockets[0], *pool, 40, 100, std::chrono::seconds(10));
+  for (uint32_t i = 0; i < 3; ++i) {
+    HeapPackBuffer * message = coalescer.acquire();
+    ASSERT_EQ(message->put(uint64_t{i}), true);
+    ASSERT_EQ(coalescer.submit(message), true);
+  }
+  ASSERT_EQ(coalescer.getNumFlushes(), 1);
+  ASSERT_EQ(coalescer.getNumPending(), 0);
+}
+
+TEST_F(MessageCoalescerTest, DeadlineTest)
+{
+  MessageCoalescer coalescer(sockets[0], *pool, 100000, 100, std::chrono::milliseconds(1));
+  HeapPackBuffer * message = coalescer.acquire();
+  ASSERT_EQ(message->put(uint32_t{1}), true);
+  ASSERT_EQ(coalescer.submit(message), true);
+  ASSERT_EQ(coalescer.getNumPending(), 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  ASSERT_EQ(coalescer.poll(), true);
+  ASSERT_EQ(coalescer.getNumPending(), 0);
+  ASSERT_EQ(coalescer.getBatchHistogram()[0], 1);
+}
+
+TEST_F(MessageCoalescerTest, SubmitAfterDeadlineTest)
+{
+  MessageCoalescer coalescer(sockets[0], *pool, 100000, 100, std::chrono::milliseconds(1));
+  HeapPackBuffer * message = coalescer.acquire();
+  ASSERT_EQ(message->put(uint32_t{1}), true);
+  ASSERT_EQ(coalescer.submit(message), true);
+  ASSERT_EQ(coalescer.getNumPending(), 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  message = coalescer.acquire();
+  ASSERT_EQ(message->put(uint32_t{2}), true);
+  ASSERT_EQ(coalescer.submit(message), true);
+  ASSERT_EQ(coalescer.getNumPending(), 0);
+  ASSERT_EQ(coalescer.getNumFlushes(), 1);
+  ASSERT_EQ(coalescer.getBatchHistogram()[1], 1);
+}
+
+TEST_F(MessageCoalescerTest, NonBlockingTest)
+{
+  const int kBufferSize = 4096;
+  setsockopt(sockets[0], SOL_SOCKET, SO_SNDBUF, &kBufferSize, sizeof(kBufferSize));
+  fcntl(sockets[0], F_SETFL, fcntl(sockets[0], F_GETFL) | O_NONBLOCK);
+  const std::string kPayload(64, 'x');
+  const uint32_t kNumMessages = 2000;
+  std::vector<uint8_t> received;
+  std::thread reader([this, &received] {
+    uint8_t chunk[1024];
+    ssize_t numRead;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    while ((numRead = read(sockets[1], chunk, sizeof(chunk))) > 0) {
+      received.insert(received.end(), chunk, chunk + numRead);
+    }
+  });
+  {
+    MessageCoalescer coalescer(sockets[0], *pool, 1000000, kNumMessages, std::chrono::seconds(10));
+    for (uint32_t i = 0; i < kNumMessages; ++i) {
+      HeapPackBuffer * message = coalescer.acquire();
+      ASSERT_EQ(message->put(i), true);
+      ASSERT_EQ(message->put(kPayload), true);
+      ASSERT_EQ(coalescer.submit(message), true);
+    }
+    ASSERT_EQ(coalescer.getNumFlushes(), 1);
+  }
+  shutdown(sockets[0], SHUT_WR);
+  reader.join();
+  MessageScanner scanner(received.data(), received.size());
+  uint32_t expectedId = 0;
+  ASSERT_EQ(scanner.scan([&expectedId, &kPayload](UnpackBuffer & _msg) {
+    ASSERT_EQ(_msg.get<uint32_t>(), expectedId++);
+    ASSERT_EQ(_msg.get(), kPayload);
+  }), kNumMessages);
+}
+
+TEST_F(MessageCoalescerTest, AlignedArrayTest)
+{
+  BufferPool largePool(1024);
+  std::vector<float> values(64);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = i * 0.5f;
+  }
+  {
+    MessageCoalescer coalescer(sockets[0], largePool, 100000, 100, std::chrono::seconds(10));
+    for (uint32_t i = 0; i < 3; ++i) {
+      HeapPackBuffer * message = coalescer.acquire();
+      ASSERT_EQ(message->setArrayAlignment(64, 16), true);
+      ASSERT_EQ(message->put(i), true);
+      ASSERT_EQ(message->put(values), true);
+      ASSERT_EQ(coalescer.submit(message), true);
+    }
+  }
+  auto received = receiveAll();
+  MessageScanner scanner(received.data(), received.size());
+  uint32_t expectedId = 0;
+  ASSERT_EQ(scanner.scan([&expectedId, &values](UnpackBuffer & _msg) {
+    ASSERT_EQ(_msg.get<uint32_t>(), expectedId++);
+    ASSERT_EQ(_msg.get<std::vector<float>>(), values);
+  }), 3);
+}
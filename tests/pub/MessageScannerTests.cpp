@@ -0,0 +1,135 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/MessageScanner.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::MessageScanner;
+
+struct MessageScannerTest : testing::Test
+{
+  HeapPackBuffer * batch;
+  HeapPackBuffer * output;
+  virtual void SetUp() {
+    batch = new HeapPackBuffer(10000);
+    output = new HeapPackBuffer(10000);
+    for (uint32_t i = 0; i < 40; ++i) {
+      HeapPackBuffer message(200);
+      message.put(i);
+      message.put("name" + std::to_string(i));
+      message.put(std::vector<double>(i % 5 + 1, i * 0.5));
+      batch->put(message.getData(), message.getDataSize());
+    }
+  };
+
+  virtual void TearDown() {
+    delete batch;
+    delete output;
+  };
+};
+
+TEST_F(MessageScannerTest, ScanTest)
+{
+  MessageScanner scanner(batch->getData(), batch->getDataSize());
+  uint32_t expectedId = 0;
+  const size_t kNumScanned = scanner.scan([&expectedId](UnpackBuffer & _msg) {
+    ASSERT_EQ(_msg.get<uint32_t>(), expectedId);
+    ++expectedId;
+  });
+  ASSERT_EQ(kNumScanned, 40);
+}
+
+TEST_F(MessageScannerTest, FilterTest)
+{
+  MessageScanner scanner(batch->getData(), batch->getDataSize());
+  const size_t kNumCopied = scanner.filter(*output, [](UnpackBuffer & _msg) {
+    return _msg.get<uint32_t>() % 10 == 3;
+  });
+  ASSERT_EQ(kNumCopied, 4);
+  MessageScanner result(output->getData(), output->getDataSize());
+  uint32_t expectedId = 3;
+  ASSERT_EQ(result.scan([&expectedId](UnpackBuffer & _msg) {
+    ASSERT_EQ(_msg.get<uint32_t>(), expectedId);
+    ASSERT_EQ(_msg.get<std::string>(), "name" + std::to_string(expectedId));
+    ASSERT_EQ(_msg.get<std::vector<double>>(), std::vector<double>(expectedId % 5 + 1, expectedId * 0.5));
+    expectedId += 10;
+  }), 4);
+}
+
+TEST_F(MessageScannerTest, ProjectTest)
+{
+  MessageScanner scanner(batch->getData(), batch->getDataSize());
+  const size_t kNumProjected = scanner.project(*output,
+    [](UnpackBuffer & _msg) {
+      return _msg.get<uint32_t>() >= 35;
+    },
+    [](UnpackBuffer & _msg, PackBuffer & _out) {
+      _msg.skip<std::string>();
+      return _out.put(_msg.get<std::vector<double>>().size());
+    });
+  ASSERT_EQ(kNumProjected, 5);
+  MessageScanner result(output->getData(), output->getDataSize());
+  size_t id = 35;
+  ASSERT_EQ(result.scan([&id](UnpackBuffer & _msg) {
+    ASSERT_EQ(_msg.get<size_t>(), id % 5 + 1);
+    ASSERT_EQ(_msg.getBufferSize(), 0);
+    ++id;
+  }), 5);
+}
+
+TEST_F(MessageScannerTest, FailedProjectionTest)
+{
+  MessageScanner scanner(batch->getData(), batch->getDataSize());
+  const size_t kNumProjected = scanner.project(*output,
+    [](UnpackBuffer & _msg) {
+      return _msg.get<uint32_t>() >= 36;
+    },
+    [](UnpackBuffer & _msg, PackBuffer & _out) {
+      const auto kName = _msg.get<std::string>();
+      return _out.put(kName) && kName != "name37";
+    });
+  ASSERT_EQ(kNumProjected, 3);
+  MessageScanner result(output->getData(), output->getDataSize());
+  std::vector<std::string> names;
+  ASSERT_EQ(result.scan([&names](UnpackBuffer & _msg) {
+    names.push_back(_msg.get<std::string>());
+  }), 3);
+  ASSERT_EQ(names, (std::vector<std::string>{"name36", "name38", "name39"}));
+}
+
+TEST_F(MessageScannerTest, TruncatedBatchTest)
+{
+  MessageScanner scanner(batch->getData(), batch->getDataSize() - 4);
+  ASSERT_EQ(scanner.scan([](UnpackBuffer &) {}), 39);
+}
+
+TEST_F(MessageScannerTest, FilterSeveralBatchesTest)
+{
+  HeapPackBuffer naturalOutput(1000, buffers::AlignMemory::Natural);
+  size_t numCopied = 0;
+  for (uint8_t i = 0; i < 4; ++i) {
+    HeapPackBuffer naturalBatch(100, buffers::AlignMemory::Natural);
+    for (uint8_t j = 0; j <= i; ++j) {
+      HeapPackBuffer message(16, buffers::AlignMemory::Natural);
+      ASSERT_EQ(message.put<uint8_t>(static_cast<uint8_t>(i * 10 + j)), true);
+      ASSERT_EQ(naturalBatch.put(message.getData(), message.getDataSize()), true);
+    }
+    MessageScanner scanner(naturalBatch.getData(), naturalBatch.getDataSize(), buffers::AlignMemory::Natural);
+    numCopied += scanner.filter(naturalOutput, [](UnpackBuffer &) {
+      return true;
+    });
+  }
+  ASSERT_EQ(numCopied, 10);
+  MessageScanner result(naturalOutput.getData(), naturalOutput.getDataSize(), buffers::AlignMemory::Natural);
+  std::vector<uint8_t> values;
+  ASSERT_EQ(result.scan([&values](UnpackBuffer & _msg) {
+    values.push_back(_msg.get<uint8_t>());
+  }), 10);
+  ASSERT_EQ(values, (std::vector<uint8_t>{0, 10, 11, 20, 21, 22, 30, 31, 32, 33}));
+}
@@ -0,0 +1,138 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/StackPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/RecordView.hpp"
+#include "pub/PackedSortedMapView.hpp"
+#include "pub/MessageScanner.hpp"
+
+using buffers::AlignMemory;
+using buffers::HeapPackBuffer;
+using buffers::StackPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::RecordView;
+using buffers::PackedSortedMapView;
+using buffers::MessageScanner;
+
+struct NaturalAlignmentTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(10000, AlignMemory::Natural);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(NaturalAlignmentTest, WireSizeTest)
+{
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  ASSERT_EQ(buffer->put<double>(2.5), true);
+  ASSERT_EQ(buffer->put<uint8_t>(3), true);
+  ASSERT_EQ(buffer->put<uint16_t>(4), true);
+  ASSERT_EQ(buffer->getDataSize(), 1 + 7 + 8 + 1 + 1 + 2);
+  for (size_t i = 1; i < 8; ++i) {
+    ASSERT_EQ(buffer->getData()[i], 0);
+  }
+  ASSERT_EQ(buffer->getData()[17], 0);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize(), AlignMemory::Natural);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 1);
+  ASSERT_EQ(unbuffer.get<double>(), 2.5);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 3);
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 4);
+}
+
+TEST_F(NaturalAlignmentTest, VectorTest)
+{
+  std::vector<double> vec0 = {0.5, 1.5, 2.5};
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  ASSERT_EQ(buffer->put(std::string("ab")), true);
+  ASSERT_EQ(buffer->put(vec0), true);
+  ASSERT_EQ(buffer->getDataSize(), 1 + 3 + 4 + 8 + 3 * sizeof(double));
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize(), AlignMemory::Natural);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 1);
+  ASSERT_EQ(unbuffer.get<std::string>(), "ab");
+  auto vec1 = unbuffer.get<std::vector<double>>();
+  ASSERT_EQ(vec0, vec1);
+}
+
+TEST_F(NaturalAlignmentTest, OverflowTest)
+{
+  StackPackBuffer<12> stackBuffer(AlignMemory::Natural);
+  ASSERT_EQ(stackBuffer.put<uint8_t>(1), true);
+  ASSERT_EQ(stackBuffer.put<uint64_t>(2), false);
+  ASSERT_EQ(stackBuffer.getDataSize(), 1);
+  ASSERT_EQ(stackBuffer.put<uint32_t>(3), true);
+  ASSERT_EQ(stackBuffer.getDataSize(), 8);
+}
+
+TEST_F(NaturalAlignmentTest, FieldTest)
+{
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  auto field = buffer->putField<uint32_t>(0);
+  ASSERT_EQ(field.offset(), 4);
+  ASSERT_EQ(buffer->patch(field, 77u), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize(), AlignMemory::Natural);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 1);
+  ASSERT_EQ(unbuffer.get<uint32_t>(), 77);
+}
+
+TEST_F(NaturalAlignmentTest, RecordViewTest)
+{
+  using MessageView = RecordView<AlignMemory::Natural, uint8_t, double, uint16_t>;
+  static_assert(MessageView::getDataSize() == 18, "Wrong size of record");
+  static_assert(MessageView::Layout::offset<1>() == 8, "Wrong offset of field");
+  static_assert(MessageView::Layout::offset<2>() == 16, "Wrong offset of field");
+  ASSERT_EQ(buffer->put<uint32_t>(5), true);
+  ASSERT_EQ(buffer->put<uint8_t>(7), true);
+  ASSERT_EQ(buffer->put<double>(2.5), true);
+  ASSERT_EQ(buffer->put<uint16_t>(3), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize(), AlignMemory::Natural);
+  ASSERT_EQ(unbuffer.get<uint32_t>(), 5);
+  ASSERT_THROW(unbuffer.get<MessageView>(), std::invalid_argument);
+}
+
+TEST_F(NaturalAlignmentTest, SortedMapViewTest)
+{
+  std::map<uint64_t, uint8_t> map0;
+  for (uint64_t i = 0; i < 100; ++i) {
+    map0[i * 7] = static_cast<uint8_t>(i);
+  }
+  ASSERT_EQ(buffer->put<uint8_t>(9), true);
+  ASSERT_EQ(buffer->put(map0), true);
+  ASSERT_EQ(buffer->put<uint8_t>(10), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize(), AlignMemory::Natural);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 9);
+  auto view = unbuffer.get<PackedSortedMapView<uint64_t, uint8_t>>();
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 10);
+  ASSERT_EQ(view.size(), map0.size());
+  for (const auto & entry : map0) {
+    uint8_t value = 0;
+    ASSERT_EQ(view.find(entry.first, value), true);
+    ASSERT_EQ(value, entry.second);
+  }
+}
+
+TEST_F(NaturalAlignmentTest, ScanTest)
+{
+  for (uint8_t i = 0; i < 10; ++i) {
+    HeapPackBuffer message(100, AlignMemory::Natural);
+    message.put(std::string(i, 'a'));
+    ASSERT_EQ(buffer->put(message.getData(), message.getDataSize()), true);
+  }
+  HeapPackBuffer output(10000, AlignMemory::Natural);
+  MessageScanner scanner(buffer->getData(), buffer->getDataSize(), AlignMemory::Natural);
+  size_t expectedSize = 0;
+  ASSERT_EQ(scanner.scan([&](UnpackBuffer & _msg) {
+    ASSERT_EQ(_msg.get<std::string>(), std::string(expectedSize++, 'a'));
+  }), 10);
+  ASSERT_EQ(scanner.filter(output, [](UnpackBuffer &) { return true; }), 10);
+  ASSERT_EQ(output.getDataSize(), buffer->getDataSize());
+}
@@ -0,0 +1,131 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/PackedHashMap.hpp"
+
+using buffers::AlignMemory;
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::PackedHashMapView;
+using buffers::PerfectHashIndex;
+
+struct PackedHashMapTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(100000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(PackedHashMapTest, FindIntTest)
+{
+  std::unordered_map<std::string, int> map0;
+  for (int i = 0; i < 1000; ++i) {
+    map0["key" + std::to_string(i)] = i;
+  }
+  ASSERT_EQ(buffer->put(buffers::withHashIndex(map0)), true);
+  ASSERT_EQ(buffer->put<uint8_t>(5), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto view = unbuffer.get<PackedHashMapView<int>>();
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 5);
+  ASSERT_EQ(view.size(), map0.size());
+  for (auto & ve : map0) {
+    int value = -1;
+    ASSERT_EQ(view.find(ve.first, value), true);
+    ASSERT_EQ(value, ve.second);
+  }
+  int value = -1;
+  ASSERT_EQ(view.find("key1000", value), false);
+  ASSERT_EQ(view.contains("key"), false);
+  ASSERT_EQ(view.contains(""), false);
+}
+
+TEST_F(PackedHashMapTest, FindStringTest)
+{
+  std::unordered_map<std::string, std::string> map0;
+  map0["1"] = "one";
+  map0["22"] = "two";
+  map0["333"] = "three";
+  ASSERT_EQ(buffer->put(buffers::withHashIndex(map0)), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto view = unbuffer.get<PackedHashMapView<std::string>>();
+  std::string value;
+  ASSERT_EQ(view.find("22", value), true);
+  ASSERT_EQ(value, "two");
+  ASSERT_EQ(view.find("333", value), true);
+  ASSERT_EQ(value, "three");
+  ASSERT_EQ(view.find("4444", value), false);
+}
+
+TEST_F(PackedHashMapTest, ArrayAlignmentTest)
+{
+  std::unordered_map<std::string, int> map0;
+  for (int i = 0; i < 100; ++i) {
+    map0["key" + std::to_string(i)] = i;
+  }
+  ASSERT_EQ(buffer->setArrayAlignment(64, 0), true);
+  ASSERT_EQ(buffer->put(buffers::withHashIndex(map0)), true);
+  ASSERT_EQ(buffer->put<uint8_t>(5), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto view = unbuffer.get<PackedHashMapView<int>>();
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 5);
+  for (auto & ve : map0) {
+    int value = -1;
+    ASSERT_EQ(view.find(ve.first, value), true);
+    ASSERT_EQ(value, ve.second);
+  }
+}
+
+TEST_F(PackedHashMapTest, OverflowTest)
+{
+  HeapPackBuffer smallBuffer(16);
+  std::unordered_map<std::string, int> map0;
+  map0["1"] = 1;
+  map0["2"] = 2;
+  ASSERT_EQ(smallBuffer.put(buffers::withHashIndex(map0)), false);
+  std::unordered_map<std::string, int> map1;
+  ASSERT_EQ(buffer->put(buffers::withHashIndex(map1)), false);
+}
+
+TEST_F(PackedHashMapTest, TightAlignedBufferTest)
+{
+  std::unordered_map<std::string, uint8_t> map0;
+  for (uint8_t i = 0; i < 8; ++i) {
+    map0["key" + std::to_string(i)] = i;
+  }
+  HeapPackBuffer buffer0(10000, AlignMemory::Bits_64);
+  ASSERT_EQ(buffer0.put<uint8_t>(1), true);
+  ASSERT_EQ(buffer0.put(buffers::withHashIndex(map0)), true);
+  const size_t kTightSize = buffer0.getDataSize();
+
+  HeapPackBuffer buffer1(kTightSize, AlignMemory::Bits_64);
+  ASSERT_EQ(buffer1.put<uint8_t>(1), true);
+  ASSERT_EQ(buffer1.put(buffers::withHashIndex(map0)), true);
+  ASSERT_EQ(buffer1.getDataSize(), kTightSize);
+  ASSERT_EQ(std::memcmp(buffer1.getData(), buffer0.getData(), kTightSize), 0);
+
+  for (size_t size = 8; size < kTightSize; ++size) {
+    HeapPackBuffer buffer2(size, AlignMemory::Bits_64);
+    ASSERT_EQ(buffer2.put<uint8_t>(1), true);
+    ASSERT_EQ(buffer2.put(buffers::withHashIndex(map0)), false);
+    ASSERT_EQ(buffer2.getDataSize(), 8);
+  }
+}
+
+TEST_F(PackedHashMapTest, EqualHashesTest)
+{
+  std::vector<uint64_t> hashes = {1, 2, 3, 42, 5, 42};
+  std::vector<uint32_t> displacements;
+  std::vector<size_t> slots;
+  ASSERT_EQ(PerfectHashIndex::build(hashes, displacements, slots), false);
+  hashes.back() = 6;
+  ASSERT_EQ(PerfectHashIndex::build(hashes, displacements, slots), true);
+}
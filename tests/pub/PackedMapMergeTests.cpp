@@ -0,0 +1,115 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/PackedMapMerge.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+
+struct PackedMapMergeTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(2000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(PackedMapMergeTest, MergeTest)
+{
+  std::map<uint64_t, std::string> map0;
+  map0[1] = "a1";
+  map0[4] = "a4";
+  map0[9] = "a9";
+  std::map<uint64_t, std::string> map1;
+  map1[2] = "b2";
+  map1[4] = "b4";
+  map1[10] = "b10";
+  std::map<uint64_t, std::string> map2;
+  map2[0] = "c0";
+  map2[9] = "c9";
+  map2[10] = "c10";
+  map2[11] = "c11";
+  HeapPackBuffer input0(200);
+  HeapPackBuffer input1(200);
+  HeapPackBuffer input2(200);
+  ASSERT_EQ(input0.put(map0), true);
+  ASSERT_EQ(input1.put(map1), true);
+  ASSERT_EQ(input2.put(map2), true);
+  ASSERT_EQ(input2.put<uint8_t>(5), true);
+  UnpackBuffer unbuffer0(input0.getData(), input0.getDataSize());
+  UnpackBuffer unbuffer1(input1.getData(), input1.getDataSize());
+  UnpackBuffer unbuffer2(input2.getData(), input2.getDataSize());
+  ASSERT_EQ((buffers::mergePackedMaps<uint64_t, std::string>(*buffer, {&unbuffer0, &unbuffer1, &unbuffer2})), true);
+  ASSERT_EQ(unbuffer2.get<uint8_t>(), 5);
+
+  std::map<uint64_t, std::string> expected = map0;
+  for (auto & ve : map1) {
+    expected[ve.first] = ve.second;
+  }
+  for (auto & ve : map2) {
+    expected[ve.first] = ve.second;
+  }
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto result = unbuffer.get<std::map<uint64_t, std::string>>();
+  ASSERT_EQ(result, expected);
+  ASSERT_EQ(unbuffer.getBufferSize(), 0);
+}
+
+TEST_F(PackedMapMergeTest, MergeVectorValuesTest)
+{
+  std::map<uint32_t, std::vector<int>> map0;
+  map0[3] = {1, 2, 3};
+  map0[7] = {7};
+  std::map<uint32_t, std::vector<int>> map1;
+  map1[5] = {5, 5};
+  HeapPackBuffer input0(200);
+  HeapPackBuffer input1(200);
+  ASSERT_EQ(input0.put(map0), true);
+  ASSERT_EQ(input1.put(map1), true);
+  UnpackBuffer unbuffer0(input0.getData(), input0.getDataSize());
+  UnpackBuffer unbuffer1(input1.getData(), input1.getDataSize());
+  ASSERT_EQ((buffers::mergePackedMaps<uint32_t, std::vector<int>>(*buffer, {&unbuffer0, &unbuffer1})), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto result = unbuffer.get<std::map<uint32_t, std::vector<int>>>();
+  ASSERT_EQ(result.size(), 3);
+  ASSERT_EQ(result[3], (std::vector<int>{1, 2, 3}));
+  ASSERT_EQ(result[5], (std::vector<int>{5, 5}));
+  ASSERT_EQ(result[7], (std::vector<int>{7}));
+}
+
+TEST_F(PackedMapMergeTest, OverflowTest)
+{
+  std::map<uint32_t, std::string> map0;
+  for (uint32_t i = 0; i < 10; ++i) {
+    map0[i] = "value" + std::to_string(i);
+  }
+  HeapPackBuffer input0(400);
+  ASSERT_EQ(input0.put(map0), true);
+  UnpackBuffer unbuffer0(input0.getData(), input0.getDataSize());
+  HeapPackBuffer smallBuffer(64);
+  ASSERT_EQ(smallBuffer.put<uint32_t>(3), true);
+  ASSERT_EQ((buffers::mergePackedMaps<uint32_t, std::string>(smallBuffer, {&unbuffer0})), false);
+  ASSERT_EQ(smallBuffer.getDataSize(), 4);
+}
+
+TEST_F(PackedMapMergeTest, SkipTest)
+{
+  std::map<std::string, std::list<double>> map0;
+  map0["1"] = {1., 2.};
+  map0["22"] = {3.};
+  ASSERT_EQ(buffer->put(map0), true);
+  ASSERT_EQ(buffer->put("Hello"), true);
+  ASSERT_EQ(buffer->put<uint16_t>(7), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  unbuffer.skip<std::map<std::string, std::list<double>>>();
+  unbuffer.skip<std::string>();
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 7);
+}
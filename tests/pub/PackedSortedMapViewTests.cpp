@@ -0,0 +1,103 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/PackedSortedMapView.hpp"
+
+using buffers::AlignMemory;
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::PackedSortedMapView;
+using buffers::PackedSortedSetView;
+
+struct PackedSortedMapViewTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(20000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(PackedSortedMapViewTest, FindTest)
+{
+  std::map<int32_t, double> map0;
+  for (int32_t i = 0; i < 1000; ++i) {
+    map0[i * 3] = i * 0.5;
+  }
+  ASSERT_EQ(buffer->put<uint8_t>(7), true);
+  ASSERT_EQ(buffer->put(map0), true);
+  ASSERT_EQ(buffer->put<uint16_t>(9), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 7);
+  auto view = unbuffer.get<PackedSortedMapView<int32_t, double>>();
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 9);
+  ASSERT_EQ(view.size(), map0.size());
+  for (int32_t i = -1; i < 3001; ++i) {
+    double value = 0;
+    const bool kFound = view.find(i, value);
+    ASSERT_EQ(kFound, map0.count(i) == 1);
+    if (kFound) {
+      ASSERT_EQ(value, map0[i]);
+    }
+  }
+}
+
+TEST_F(PackedSortedMapViewTest, RangeTest)
+{
+  std::map<uint64_t, uint8_t> map0;
+  for (uint64_t i = 0; i < 100; ++i) {
+    map0[i * 10] = static_cast<uint8_t>(i);
+  }
+  ASSERT_EQ(buffer->put(map0), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto view = unbuffer.get<PackedSortedMapView<uint64_t, uint8_t>>();
+  auto range = view.range(95, 155);
+  std::vector<std::pair<uint64_t, uint8_t>> result;
+  for (auto it = range.first; it != range.second; ++it) {
+    result.push_back(*it);
+  }
+  std::vector<std::pair<uint64_t, uint8_t>> expected(map0.lower_bound(95), map0.lower_bound(155));
+  ASSERT_EQ(result, expected);
+  ASSERT_EQ(view.upper_bound(990).index(), view.size());
+  ASSERT_EQ(view.lower_bound(0).index(), 0);
+}
+
+TEST_F(PackedSortedMapViewTest, AlignmentTest)
+{
+  uint8_t array[200];
+  PackBuffer packBuffer(array, sizeof(array), AlignMemory::Bits_8);
+  std::map<uint8_t, uint16_t> map0;
+  map0[1] = 100;
+  map0[5] = 500;
+  map0[9] = 900;
+  ASSERT_EQ(packBuffer.put(map0), true);
+  UnpackBuffer unbuffer(packBuffer.getData(), packBuffer.getDataSize(), AlignMemory::Bits_8);
+  auto view = unbuffer.get<PackedSortedMapView<uint8_t, uint16_t>>();
+  uint16_t value = 0;
+  ASSERT_EQ(view.find(5, value), true);
+  ASSERT_EQ(value, 500);
+  ASSERT_EQ(view.find(6, value), false);
+}
+
+TEST_F(PackedSortedMapViewTest, SetTest)
+{
+  std::set<int16_t> set0;
+  for (int16_t i = -50; i < 50; i += 2) {
+    set0.insert(i);
+  }
+  ASSERT_EQ(buffer->put(set0), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto view = unbuffer.get<PackedSortedSetView<int16_t>>();
+  ASSERT_EQ(view.size(), set0.size());
+  for (int16_t i = -60; i < 60; ++i) {
+    ASSERT_EQ(view.contains(i), set0.count(i) == 1);
+  }
+}
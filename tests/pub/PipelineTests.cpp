@@ -0,0 +1,131 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <ctime>
+#include "pub/Pipeline.hpp"
+#include "pub/UnpackBuffer.hpp"
+
+using buffers::BufferPool;
+using buffers::HeapPackBuffer;
+using buffers::Pipeline;
+using buffers::UnpackBuffer;
+
+struct PipelineTest : testing::Test
+{
+  BufferPool * pool;
+  virtual void SetUp() {
+    pool = new BufferPool(64);
+  };
+
+  virtual void TearDown() {
+    delete pool;
+  };
+};
+
+TEST_F(PipelineTest, OrderTest)
+{
+  std::vector<uint32_t> written;
+  {
+    Pipeline pipeline(*pool, 4);
+    pipeline.addStage([](HeapPackBuffer * _buffer) {
+      UnpackBuffer unbuffer(_buffer->getData(), _buffer->getDataSize());
+      const uint32_t kValue = unbuffer.get<uint32_t>();
+      std::this_thread::sleep_for(std::chrono::microseconds((kValue * 7) % 50));
+      _buffer->put<uint32_t>(kValue * 2);
+      return _buffer;
+    }, 4);
+    pipeline.addStage([&written](HeapPackBuffer * _buffer) {
+      UnpackBuffer unbuffer(_buffer->getData(), _buffer->getDataSize());
+      unbuffer.get<uint32_t>();
+      written.push_back(unbuffer.get<uint32_t>());
+      return _buffer;
+    });
+    pipeline.start();
+    for (uint32_t i = 0; i < 200; ++i) {
+      HeapPackBuffer * buffer = pipeline.acquire();
+      ASSERT_EQ(buffer->put(i), true);
+      pipeline.submit(buffer);
+    }
+    pipeline.stop();
+    ASSERT_EQ(pipeline.getNumCompleted(), 200);
+    ASSERT_EQ(pipeline.getNumProcessed(0), 200);
+    ASSERT_GE(pipeline.getUtilisation(0), 0.0);
+    ASSERT_LE(pipeline.getUtilisation(0), 1.0);
+  }
+  ASSERT_EQ(written.size(), 200);
+  for (uint32_t i = 0; i < 200; ++i) {
+    ASSERT_EQ(written[i], i * 2);
+  }
+  ASSERT_LE(pool->getNumBuffers(), 4 * 2 + 4 + 2);
+}
+
+TEST_F(PipelineTest, DropTest)
+{
+  std::vector<uint32_t> written;
+  Pipeline pipeline(*pool, 2);
+  pipeline.addStage([](HeapPackBuffer * _buffer) -> HeapPackBuffer * {
+    UnpackBuffer unbuffer(_buffer->getData(), _buffer->getDataSize());
+    return unbuffer.get<uint32_t>() % 2 == 0 ? _buffer : nullptr;
+  }, 2);
+  pipeline.addStage([&written](HeapPackBuffer * _buffer) {
+    UnpackBuffer unbuffer(_buffer->getData(), _buffer->getDataSize());
+    written.push_back(unbuffer.get<uint32_t>());
+    return _buffer;
+  });
+  pipeline.start();
+  for (uint32_t i = 0; i < 100; ++i) {
+    HeapPackBuffer * buffer = pipeline.acquire();
+    ASSERT_EQ(buffer->put(i), true);
+    pipeline.submit(buffer);
+  }
+  pipeline.stop();
+  ASSERT_EQ(pipeline.getNumCompleted(), 100);
+  ASSERT_EQ(written.size(), 50);
+  for (uint32_t i = 0; i < 50; ++i) {
+    ASSERT_EQ(written[i], i * 2);
+  }
+}
+
+TEST_F(PipelineTest, IdleTest)
+{
+  Pipeline pipeline(*pool, 4);
+  pipeline.addStage([](HeapPackBuffer * _buffer) {
+    return _buffer;
+  }, 4);
+  pipeline.addStage([](HeapPackBuffer * _buffer) {
+    return _buffer;
+  });
+  pipeline.start();
+  const std::clock_t kStart = std::clock();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  const double kCpuSeconds = static_cast<double>(std::clock() - kStart) / CLOCKS_PER_SEC;
+  ASSERT_LT(kCpuSeconds, 0.05);
+  HeapPackBuffer * buffer = pipeline.acquire();
+  ASSERT_EQ(buffer->put(uint32_t{1}), true);
+  pipeline.submit(buffer);
+  pipeline.stop();
+  ASSERT_EQ(pipeline.getNumCompleted(), 1);
+}
+
+TEST_F(PipelineTest, RestartTest)
+{
+  Pipeline pipeline(*pool, 2);
+  pipeline.addStage([](HeapPackBuffer * _buffer) {
+    return _buffer;
+  }, 2);
+  pipeline.addStage([](HeapPackBuffer * _buffer) {
+    return _buffer;
+  });
+  for (uint32_t run = 0; run < 2; ++run) {
+    pipeline.start();
+    for (uint32_t i = 0; i < 50; ++i) {
+      HeapPackBuffer * buffer = pipeline.acquire();
+      ASSERT_EQ(buffer->put(i), true);
+      pipeline.submit(buffer);
+    }
+    pipeline.stop();
+    ASSERT_EQ(pipeline.getNumCompleted(), 50 * (run + 1));
+  }
+}
@@ -0,0 +1,71 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/PackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/RecordView.hpp"
+
+using buffers::AlignMemory;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::RecordView;
+
+struct RecordViewTest : testing::Test
+{
+  uint8_t array[100];
+  PackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new PackBuffer(array, sizeof(array));
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(RecordViewTest, ReadFieldsTest)
+{
+  using MessageView = RecordView<AlignMemory::Bits_32, uint8_t, double, int16_t, uint64_t>;
+  static_assert(MessageView::getDataSize() == 4 + 8 + 4 + 8, "Wrong size of record");
+  static_assert(MessageView::Layout::offset<2>() == 12, "Wrong offset of field");
+  ASSERT_EQ(buffer->put<uint8_t>(7), true);
+  ASSERT_EQ(buffer->put<double>(2.5), true);
+  ASSERT_EQ(buffer->put<int16_t>(-3), true);
+  ASSERT_EQ(buffer->put<uint64_t>(1ULL << 40), true);
+  ASSERT_EQ(buffer->getDataSize(), MessageView::getDataSize());
+  MessageView view(buffer->getData());
+  ASSERT_EQ(view.get<0>(), 7);
+  ASSERT_EQ(view.get<1>(), 2.5);
+  ASSERT_EQ(view.get<2>(), -3);
+  ASSERT_EQ(view.get<3>(), 1ULL << 40);
+}
+
+TEST_F(RecordViewTest, UnpackViewTest)
+{
+  using MessageView = RecordView<AlignMemory::Bits_8, uint8_t, uint32_t>;
+  PackBuffer packBuffer(array, sizeof(array), AlignMemory::Bits_8);
+  ASSERT_EQ(packBuffer.put<uint8_t>(1), true);
+  ASSERT_EQ(packBuffer.put<uint32_t>(100000), true);
+  ASSERT_EQ(packBuffer.put<uint8_t>(2), true);
+  ASSERT_EQ(packBuffer.put<uint32_t>(200000), true);
+  ASSERT_EQ(packBuffer.put<uint16_t>(3), true);
+  UnpackBuffer unbuffer(packBuffer.getData(), packBuffer.getDataSize(), AlignMemory::Bits_8);
+  auto view0 = unbuffer.get<MessageView>();
+  auto view1 = unbuffer.get<MessageView>();
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 3);
+  ASSERT_EQ(view0.get<0>(), 1);
+  ASSERT_EQ(view0.get<1>(), 100000);
+  ASSERT_EQ(view1.get<0>(), 2);
+  ASSERT_EQ(view1.get<1>(), 200000);
+}
+
+TEST_F(RecordViewTest, WrongAlignmentTest)
+{
+  using MessageView = RecordView<AlignMemory::Bits_64, uint8_t, uint32_t>;
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  ASSERT_EQ(buffer->put<uint32_t>(2), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_THROW(unbuffer.get<MessageView>(), std::invalid_argument);
+}
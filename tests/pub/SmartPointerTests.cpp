@@ -0,0 +1,214 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+
+struct GraphNode {
+  int32_t value;
+  std::shared_ptr<GraphNode> left;
+  std::shared_ptr<GraphNode> right;
+};
+
+namespace buffers {
+  template <>
+  class PackBuffer::DelegatePackBuffer<GraphNode> {
+   public:
+    template <typename TBufferContext>
+    static bool put(TBufferContext & _ctx, const GraphNode & _node) {
+      return DelegatePackBuffer<int32_t>{}.put(_ctx, _node.value) &&
+             DelegatePackBuffer<std::shared_ptr<GraphNode>>{}.put(_ctx, _node.left) &&
+             DelegatePackBuffer<std::shared_ptr<GraphNode>>{}.put(_ctx, _node.right);
+    }
+
+    static size_t getTypeSize(const GraphNode & _node) {
+      return sizeof(int32_t) +
+             DelegatePackBuffer<std::shared_ptr<GraphNode>>{}.getTypeSize(_node.left) +
+             DelegatePackBuffer<std::shared_ptr<GraphNode>>{}.getTypeSize(_node.right);
+    }
+  };
+
+  template <>
+  class UnpackBuffer::DelegateUnpackBuffer<GraphNode> {
+   public:
+    template <typename TBufferContext>
+    static GraphNode get(TBufferContext & _ctx) {
+      GraphNode node;
+      node.value = DelegateUnpackBuffer<int32_t>{}.get(_ctx);
+      node.left = DelegateUnpackBuffer<std::shared_ptr<GraphNode>>{}.get(_ctx);
+      node.right = DelegateUnpackBuffer<std::shared_ptr<GraphNode>>{}.get(_ctx);
+      return node;
+    }
+
+    template <typename TBufferContext>
+    static void skip(TBufferContext & _ctx) {
+      get(_ctx);
+    }
+  };
+}
+
+static std::shared_ptr<GraphNode> makeNode(int32_t _value,
+                                           std::shared_ptr<GraphNode> _left = nullptr,
+                                           std::shared_ptr<GraphNode> _right = nullptr) {
+  std::shared_ptr<GraphNode> node = std::make_shared<GraphNode>();
+  node->value = _value;
+  node->left = _left;
+  node->right = _right;
+  return node;
+}
+
+struct SmartPointerTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(1000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(SmartPointerTest, SharedNodeTest)
+{
+  auto leaf = makeNode(3);
+  auto root = makeNode(0, makeNode(1, leaf, leaf), makeNode(2, leaf));
+  ASSERT_EQ(buffer->put(root), true);
+  // 9 tags: 4 new nodes, 2 back-references and 3 null pointers, leaf is packed once
+  ASSERT_EQ(buffer->getDataSize(), 9 * sizeof(size_t) + 4 * sizeof(int32_t));
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto root1 = unbuffer.get<std::shared_ptr<GraphNode>>();
+  ASSERT_EQ(root1->value, 0);
+  ASSERT_EQ(root1->left->value, 1);
+  ASSERT_EQ(root1->right->value, 2);
+  ASSERT_EQ(root1->left->left->value, 3);
+  ASSERT_EQ(root1->left->left, root1->left->right);
+  ASSERT_EQ(root1->left->left, root1->right->left);
+  ASSERT_EQ(root1->right->right, nullptr);
+  ASSERT_EQ(root1->left->left.use_count(), 4);
+}
+
+TEST_F(SmartPointerTest, SharedAcrossValuesTest)
+{
+  auto str = std::make_shared<std::string>("shared");
+  std::list<std::shared_ptr<std::string>> lst0 = {str, nullptr, str, str};
+  ASSERT_EQ(buffer->put(lst0), true);
+  ASSERT_EQ(buffer->put(str), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto lst1 = unbuffer.get<std::list<std::shared_ptr<std::string>>>();
+  auto str1 = unbuffer.get<std::shared_ptr<std::string>>();
+  ASSERT_EQ(lst1.size(), 4);
+  ASSERT_EQ(*lst1.front(), "shared");
+  ASSERT_EQ(*std::next(lst1.begin(), 1), nullptr);
+  ASSERT_EQ(*std::next(lst1.begin(), 2), lst1.front());
+  ASSERT_EQ(str1, lst1.front());
+}
+
+TEST_F(SmartPointerTest, SharedVectorTest)
+{
+  auto leaf = makeNode(3);
+  std::vector<std::shared_ptr<GraphNode>> vec0 = {makeNode(1, leaf), leaf, nullptr, makeNode(2, nullptr, leaf)};
+  ASSERT_EQ(buffer->put(vec0), true);
+  const size_t kDataSize = buffer->getDataSize();
+  UnpackBuffer unbuffer(buffer->getData(), kDataSize);
+  auto vec1 = unbuffer.get<std::vector<std::shared_ptr<GraphNode>>>();
+  ASSERT_EQ(vec1.size(), 4);
+  ASSERT_EQ(vec1[0]->value, 1);
+  ASSERT_EQ(vec1[1], vec1[0]->left);
+  ASSERT_EQ(vec1[2], nullptr);
+  ASSERT_EQ(vec1[3]->value, 2);
+  ASSERT_EQ(vec1[3]->right, vec1[1]);
+  ASSERT_EQ(vec1[1]->value, 3);
+
+  // Repeated objects are packed once, so exactly sized buffer is enough
+  HeapPackBuffer tightBuffer(kDataSize);
+  ASSERT_EQ(tightBuffer.put(vec0), true);
+  ASSERT_EQ(tightBuffer.getDataSize(), kDataSize);
+  HeapPackBuffer smallBuffer(kDataSize - 1);
+  ASSERT_EQ(smallBuffer.put(vec0), false);
+  ASSERT_EQ(smallBuffer.getDataSize(), 0);
+}
+
+TEST_F(SmartPointerTest, ResetTest)
+{
+  auto str = std::make_shared<std::string>("str");
+  ASSERT_EQ(buffer->put(str), true);
+  const size_t kSize = buffer->getDataSize();
+  buffer->reset();
+  ASSERT_EQ(buffer->put(str), true);
+  ASSERT_EQ(buffer->getDataSize(), kSize);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(*unbuffer.get<std::shared_ptr<std::string>>(), "str");
+}
+
+TEST_F(SmartPointerTest, OverflowTest)
+{
+  HeapPackBuffer smallBuffer(16);
+  auto str = std::make_shared<std::string>("long string that does not fit");
+  ASSERT_EQ(smallBuffer.put(str), false);
+  ASSERT_EQ(smallBuffer.getDataSize(), 0);
+  auto small = std::make_shared<std::string>("fit");
+  ASSERT_EQ(smallBuffer.put(small), true);
+  UnpackBuffer unbuffer(smallBuffer.getData(), smallBuffer.getDataSize());
+  ASSERT_EQ(*unbuffer.get<std::shared_ptr<std::string>>(), "fit");
+}
+
+TEST_F(SmartPointerTest, AliasedMemberTest)
+{
+  auto node = makeNode(5);
+  std::shared_ptr<int32_t> value(node, &node->value);
+  ASSERT_EQ(static_cast<void *>(value.get()), static_cast<void *>(node.get()));
+  ASSERT_EQ(buffer->put(node), true);
+  ASSERT_EQ(buffer->put(value), true);
+  ASSERT_EQ(buffer->put(value), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto node1 = unbuffer.get<std::shared_ptr<GraphNode>>();
+  auto value1 = unbuffer.get<std::shared_ptr<int32_t>>();
+  ASSERT_EQ(node1->value, 5);
+  ASSERT_EQ(*value1, 5);
+  ASSERT_EQ(unbuffer.get<std::shared_ptr<int32_t>>(), value1);
+}
+
+TEST_F(SmartPointerTest, TypeMismatchTest)
+{
+  auto value = std::make_shared<uint32_t>(7);
+  ASSERT_EQ(buffer->put(value), true);
+  ASSERT_EQ(buffer->put(value), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(*unbuffer.get<std::shared_ptr<uint32_t>>(), 7);
+  ASSERT_THROW(unbuffer.get<std::shared_ptr<float>>(), std::invalid_argument);
+}
+
+TEST_F(SmartPointerTest, RollbackTest)
+{
+  auto str = std::make_shared<std::string>("str");
+  ASSERT_EQ(buffer->put<uint32_t>(1), true);
+  const size_t kSize = buffer->getDataSize();
+  ASSERT_EQ(buffer->put(str), true);
+  buffer->rollback(kSize);
+  ASSERT_EQ(buffer->getDataSize(), kSize);
+  ASSERT_EQ(buffer->put(str), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<uint32_t>(), 1);
+  ASSERT_EQ(*unbuffer.get<std::shared_ptr<std::string>>(), "str");
+}
+
+TEST_F(SmartPointerTest, UniquePtrTest)
+{
+  std::unique_ptr<double> value0(new double(2.5));
+  std::unique_ptr<double> null0;
+  ASSERT_EQ(buffer->put(value0), true);
+  ASSERT_EQ(buffer->put(null0), true);
+  ASSERT_EQ(buffer->put<uint8_t>(7), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto value1 = unbuffer.get<std::unique_ptr<double>>();
+  ASSERT_EQ(*value1, 2.5);
+  ASSERT_EQ(unbuffer.get<std::unique_ptr<double>>(), nullptr);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 7);
+}
@@ -0,0 +1,58 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/StaticString.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::StaticString;
+
+struct StaticStringTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(1000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(StaticStringTest, AssignTest)
+{
+  StaticString<5> str0("abc");
+  ASSERT_EQ(str0.size(), 3);
+  ASSERT_EQ(str0.append("def", 3), false);
+  ASSERT_EQ(str0 == "abcde", true);
+  ASSERT_EQ(str0.assign("xy", 2), true);
+  ASSERT_EQ(str0.str(), "xy");
+}
+
+TEST_F(StaticStringTest, CompatibleWithStringTest)
+{
+  StaticString<16> str0("static");
+  ASSERT_EQ(buffer->put(str0), true);
+  ASSERT_EQ(buffer->put(std::string("standard")), true);
+  ASSERT_EQ(buffer->put<uint16_t>(9), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<std::string>(), "static");
+  ASSERT_EQ(unbuffer.get<StaticString<16>>() == "standard", true);
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 9);
+}
+
+TEST_F(StaticStringTest, OverflowTest)
+{
+  ASSERT_EQ(buffer->put(std::string("too long string")), true);
+  ASSERT_EQ(buffer->put<uint16_t>(9), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_THROW(unbuffer.get<StaticString<8>>(), std::length_error);
+  unbuffer.reset();
+  unbuffer.skip<StaticString<8>>();
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 9);
+}
@@ -0,0 +1,76 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/StaticVector.hpp"
+
+using buffers::AlignMemory;
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::StaticVector;
+
+using Int32Vector = StaticVector<int32_t, 4>;
+using UInt16Vector = StaticVector<uint16_t, 4>;
+
+struct StaticVectorTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(1000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(StaticVectorTest, PushBackTest)
+{
+  StaticVector<int32_t, 3> vec0;
+  ASSERT_EQ(vec0.push_back(1), true);
+  ASSERT_EQ(vec0.push_back(2), true);
+  ASSERT_EQ(vec0.push_back(3), true);
+  ASSERT_EQ(vec0.push_back(4), false);
+  ASSERT_EQ(vec0.full(), true);
+  ASSERT_EQ(vec0.size(), 3);
+  ASSERT_EQ(vec0[2], 3);
+}
+
+TEST_F(StaticVectorTest, CompatibleWithVectorTest)
+{
+  StaticVector<double, 8> vec0 = {0.5, 1.5, 2.5};
+  std::vector<double> vec1 = {3.5, 4.5};
+  ASSERT_EQ(buffer->put(vec0), true);
+  ASSERT_EQ(buffer->put(vec1), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto vec2 = unbuffer.get<std::vector<double>>();
+  auto vec3 = unbuffer.get<StaticVector<double, 8>>();
+  ASSERT_EQ(vec2, std::vector<double>(vec0.begin(), vec0.end()));
+  ASSERT_EQ(std::vector<double>(vec3.begin(), vec3.end()), vec1);
+}
+
+TEST_F(StaticVectorTest, EmptyTest)
+{
+  UInt16Vector vec0;
+  ASSERT_EQ(buffer->put(vec0), true);
+  ASSERT_EQ(buffer->put<uint8_t>(7), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<UInt16Vector>(), vec0);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 7);
+}
+
+TEST_F(StaticVectorTest, OverflowTest)
+{
+  std::vector<int32_t> vec0 = {1, 2, 3, 4, 5};
+  ASSERT_EQ(buffer->put(vec0), true);
+  ASSERT_EQ(buffer->put<uint8_t>(7), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_THROW(unbuffer.get<Int32Vector>(), std::length_error);
+  unbuffer.reset();
+  unbuffer.skip<Int32Vector>();
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 7);
+}
@@ -0,0 +1,104 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/Tensor.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::TensorView;
+
+struct TensorTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(10000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(TensorTest, DenseTest)
+{
+  float matrix0[2][3] = {{1.f, 2.f, 3.f}, {4.f, 5.f, 6.f}};
+  TensorView<float> tensor0(&matrix0[0][0], {2, 3});
+  ASSERT_EQ(tensor0.isContiguous(), true);
+  ASSERT_EQ(buffer->put(tensor0), true);
+  ASSERT_EQ(buffer->put<uint8_t>(7), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto tensor1 = unbuffer.get<TensorView<float>>();
+  ASSERT_EQ(tensor1.rank(), 2);
+  ASSERT_EQ(tensor1.shape(0), 2);
+  ASSERT_EQ(tensor1.shape(1), 3);
+  ASSERT_EQ(tensor1.stride(0), 3);
+  ASSERT_EQ(tensor1.stride(1), 1);
+  ASSERT_EQ(tensor1.size(), 6);
+  ASSERT_EQ(tensor1.isAligned(alignof(float)), true);
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      ASSERT_EQ(tensor1(i, j), matrix0[i][j]);
+    }
+  }
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 7);
+}
+
+TEST_F(TensorTest, StridedTest)
+{
+  int32_t matrix0[3][4] = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+  // Transposed 2x3 sub-matrix of columns 1..2
+  TensorView<int32_t> tensor0(&matrix0[0][1], {2, 3}, {1, 4});
+  ASSERT_EQ(tensor0.isContiguous(), false);
+  ASSERT_EQ(buffer->put(tensor0), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  auto tensor1 = unbuffer.get<TensorView<int32_t>>();
+  ASSERT_EQ(tensor1.isContiguous(), true);
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      ASSERT_EQ(tensor1(i, j), matrix0[j][i + 1]);
+    }
+  }
+}
+
+TEST_F(TensorTest, AlignedPayloadTest)
+{
+  ASSERT_EQ(buffer->setArrayAlignment(64, 16), true);
+  std::vector<double> values(32, 2.5);
+  ASSERT_EQ(buffer->put<uint8_t>(1), true);
+  ASSERT_EQ(buffer->put(TensorView<double>(values.data(), {4, 8})), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 1);
+  auto tensor1 = unbuffer.get<TensorView<double>>();
+  ASSERT_EQ((reinterpret_cast<const uint8_t *>(tensor1.data()) - buffer->getData()) % 64, 0);
+  ASSERT_EQ(tensor1(3, 7), 2.5);
+}
+
+TEST_F(TensorTest, TypeMismatchTest)
+{
+  int16_t values[4] = {1, 2, 3, 4};
+  ASSERT_EQ(buffer->put(TensorView<int16_t>(values, {4})), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_THROW(unbuffer.get<TensorView<uint16_t>>(), std::invalid_argument);
+}
+
+TEST_F(TensorTest, OverflowTest)
+{
+  HeapPackBuffer smallBuffer(32);
+  int64_t values[4] = {1, 2, 3, 4};
+  ASSERT_EQ(smallBuffer.put(TensorView<int64_t>(values, {2, 2})), false);
+  ASSERT_EQ(smallBuffer.getDataSize(), 0);
+}
+
+TEST_F(TensorTest, CorruptedRankTest)
+{
+  ASSERT_EQ(buffer->put<uint8_t>(0), true);
+  ASSERT_EQ(buffer->put<size_t>(1000000), true);
+  UnpackBuffer unbuffer0(buffer->getData(), buffer->getDataSize());
+  ASSERT_THROW(unbuffer0.get<TensorView<float>>(), std::invalid_argument);
+  UnpackBuffer unbuffer1(buffer->getData(), buffer->getDataSize());
+  ASSERT_THROW(unbuffer1.skip<TensorView<float>>(), std::invalid_argument);
+}
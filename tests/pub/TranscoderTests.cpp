@@ -0,0 +1,78 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/Transcoder.hpp"
+
+using buffers::AlignMemory;
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::Transcoder;
+
+struct TranscoderTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(10000, AlignMemory::Bits_32);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(TranscoderTest, TightPackingTest)
+{
+  std::map<std::string, std::vector<int16_t>> map0 = {{"one", {1}}, {"two", {2, 2}}};
+  std::list<uint8_t> lst0 = {1, 2, 3};
+  ASSERT_EQ(buffer->put<uint8_t>(7), true);
+  ASSERT_EQ(buffer->put(map0), true);
+  ASSERT_EQ(buffer->put(lst0), true);
+  ASSERT_EQ(buffer->put("end"), true);
+
+  HeapPackBuffer tight(10000, AlignMemory::Bits_8);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize(), AlignMemory::Bits_32);
+  ASSERT_EQ((Transcoder::transcode<uint8_t, std::map<std::string, std::vector<int16_t>>,
+                                   std::list<uint8_t>, std::string>(unbuffer, tight)), true);
+  ASSERT_EQ(unbuffer.getBufferSize(), 0);
+
+  HeapPackBuffer expected(10000, AlignMemory::Bits_8);
+  ASSERT_EQ(expected.put<uint8_t>(7), true);
+  ASSERT_EQ(expected.put(map0), true);
+  ASSERT_EQ(expected.put(lst0), true);
+  ASSERT_EQ(expected.put("end"), true);
+  ASSERT_EQ(isEqualPacked(tight, expected), true);
+  ASSERT_LT(tight.getDataSize(), buffer->getDataSize());
+}
+
+TEST_F(TranscoderTest, NaturalAlignmentTest)
+{
+  std::vector<double> vec0 = {1.5, 2.5, 3.5};
+  std::unique_ptr<int64_t> ptr0(new int64_t(42));
+  ASSERT_EQ(buffer->put<uint16_t>(3), true);
+  ASSERT_EQ(buffer->put(vec0), true);
+  ASSERT_EQ(buffer->put(ptr0), true);
+
+  HeapPackBuffer natural(10000, AlignMemory::Natural);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize(), AlignMemory::Bits_32);
+  ASSERT_EQ((Transcoder::transcode<uint16_t, std::vector<double>, std::unique_ptr<int64_t>>(unbuffer, natural)),
+            true);
+
+  UnpackBuffer unbuffer1(natural.getData(), natural.getDataSize(), AlignMemory::Natural);
+  ASSERT_EQ(unbuffer1.get<uint16_t>(), 3);
+  ASSERT_EQ(unbuffer1.get<std::vector<double>>(), vec0);
+  ASSERT_EQ(*unbuffer1.get<std::unique_ptr<int64_t>>(), 42);
+}
+
+TEST_F(TranscoderTest, OverflowTest)
+{
+  std::set<std::string> set0 = {"first", "second", "third"};
+  ASSERT_EQ(buffer->put(set0), true);
+  HeapPackBuffer small(12, AlignMemory::Bits_8);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize(), AlignMemory::Bits_32);
+  ASSERT_EQ(Transcoder::transcode<std::set<std::string>>(unbuffer, small), false);
+}
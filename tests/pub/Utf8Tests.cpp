@@ -0,0 +1,209 @@
+//
+// Created by redra on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <random>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/StaticString.hpp"
+#include "pub/Utf8.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::StaticString;
+using buffers::Utf8;
+
+static bool isValid(const std::string & _str) {
+  return Utf8::validate(reinterpret_cast<const uint8_t *>(_str.data()), _str.size());
+}
+
+/**
+ * Reference validation by decoding of code points
+ */
+static bool isValidReference(const uint8_t * _pData, const size_t _size) {
+  static const uint32_t kMinCodePoint[] = {0, 0, 0x80, 0x800, 0x10000};
+  size_t i = 0;
+  while (i < _size) {
+    uint32_t codePoint = _pData[i];
+    size_t seqSize = 1;
+    if ((codePoint & 0xE0) == 0xC0) {
+      seqSize = 2;
+      codePoint &= 0x1F;
+    } else if ((codePoint & 0xF0) == 0xE0) {
+      seqSize = 3;
+      codePoint &= 0x0F;
+    } else if ((codePoint & 0xF8) == 0xF0) {
+      seqSize = 4;
+      codePoint &= 0x07;
+    } else if (codePoint >= 0x80) {
+      return false;
+    }
+    if (_size - i < seqSize) {
+      return false;
+    }
+    for (size_t j = 1; j < seqSize; ++j) {
+      if ((_pData[i + j] & 0xC0) != 0x80) {
+        return false;
+      }
+      codePoint = (codePoint << 6) | (_pData[i + j] & 0x3F);
+    }
+    if (seqSize > 1 && (codePoint < kMinCodePoint[seqSize] || codePoint > 0x10FFFF ||
+                        (codePoint >= 0xD800 && codePoint <= 0xDFFF))) {
+      return false;
+    }
+    i += seqSize;
+  }
+  return true;
+}
+
+/**
+ * Method for creating valid text of random characters, with one random byte replaced in half of cases
+ */
+static std::string createRandomText(std::mt19937 & _random, const size_t _size) {
+  static const char * const kChars[] = {"a", "\x7F", "\xC2\x80", "\xD0\xBF", "\xDF\xBF", "\xE0\xA0\x80",
+                                        "\xE2\x82\xAC", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF",
+                                        "\xF0\x90\x80\x80", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF"};
+  std::string text;
+  while (text.size() < _size) {
+    text += kChars[_random() % 13];
+  }
+  if (_random() % 2 == 0) {
+    text[_random() % text.size()] = static_cast<char>(_random() % 256);
+  }
+  return text;
+}
+
+struct Utf8Test : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(1000);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(Utf8Test, ValidateTest)
+{
+  ASSERT_EQ(isValid("plain ascii text that is longer than one block of sixteen bytes"), true);
+  ASSERT_EQ(isValid("\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82"), true);
+  ASSERT_EQ(isValid("\xE2\x82\xAC and \xF0\x9F\x98\x80"), true);
+  ASSERT_EQ(isValid("\xF4\x8F\xBF\xBF"), true);
+  ASSERT_EQ(isValid("\xC0\xAF"), false);
+  ASSERT_EQ(isValid("\xE0\x80\xAF"), false);
+  ASSERT_EQ(isValid("\xED\xA0\x80"), false);
+  ASSERT_EQ(isValid("\xF4\x90\x80\x80"), false);
+  ASSERT_EQ(isValid("\xF5\x80\x80\x80"), false);
+  ASSERT_EQ(isValid("0123456789abcdef\x80"), false);
+  ASSERT_EQ(isValid("truncated \xE2\x82"), false);
+  ASSERT_EQ(isValid(std::string("null\0inside", 11)), true);
+}
+
+TEST_F(Utf8Test, ScanStringTest)
+{
+  const std::string kStr = std::string(40, 'a') + "\xD0\xBF" + std::string(20, 'b');
+  size_t length = 0;
+  ASSERT_EQ(Utf8::scanString(reinterpret_cast<const uint8_t *>(kStr.c_str()), kStr.size() + 1, length), true);
+  ASSERT_EQ(length, kStr.size());
+  ASSERT_EQ(Utf8::scanString(reinterpret_cast<const uint8_t *>(kStr.c_str()), kStr.size(), length), false);
+  const std::string kBroken = std::string("\xE2\x82") + '\0';
+  ASSERT_EQ(Utf8::scanString(reinterpret_cast<const uint8_t *>(kBroken.c_str()), kBroken.size() + 1, length), false);
+}
+
+TEST_F(Utf8Test, UnpackValidTest)
+{
+  ASSERT_EQ(buffer->put(std::string("\xE2\x82\xAC price")), true);
+  ASSERT_EQ(buffer->put("\xF0\x9F\x98\x80"), true);
+  ASSERT_EQ(buffer->put(std::string("static")), true);
+  ASSERT_EQ(buffer->put<uint16_t>(7), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  unbuffer.setUtf8Validation(true);
+  ASSERT_EQ(unbuffer.get<std::string>(), "\xE2\x82\xAC price");
+  ASSERT_EQ(std::string(unbuffer.get()), "\xF0\x9F\x98\x80");
+  ASSERT_EQ(unbuffer.get<StaticString<8>>() == "static", true);
+  ASSERT_EQ(unbuffer.get<uint16_t>(), 7);
+}
+
+TEST_F(Utf8Test, UnpackInvalidTest)
+{
+  ASSERT_EQ(buffer->put(std::string("bad \xC0\xAF")), true);
+  UnpackBuffer unbuffer(buffer->getData(), buffer->getDataSize());
+  ASSERT_EQ(unbuffer.get<std::string>(), "bad \xC0\xAF");
+  unbuffer.reset();
+  unbuffer.setUtf8Validation(true);
+  ASSERT_THROW(unbuffer.get<std::string>(), std::invalid_argument);
+  unbuffer.reset();
+  ASSERT_THROW(unbuffer.get<StaticString<16>>(), std::invalid_argument);
+}
+
+TEST_F(Utf8Test, RandomTextTest)
+{
+  std::mt19937 random(7);
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < 20000; ++i) {
+    const std::string kText = createRandomText(random, random() % 200 + 1);
+    const size_t kOffset = random() % 32;
+    data.assign(kOffset, 'x');
+    data.insert(data.end(), kText.begin(), kText.end());
+    const uint8_t * pText = data.data() + kOffset;
+    ASSERT_EQ(Utf8::validate(pText, kText.size()), isValidReference(pText, kText.size())) << i;
+
+    data.push_back(0);
+    for (size_t j = random() % 64; j > 0; --j) {
+      data.push_back(static_cast<uint8_t>(random() % 256));
+    }
+    pText = data.data() + kOffset;
+    const size_t kNullPos = kText.find('\0');
+    const size_t kLength = kNullPos != std::string::npos ? kNullPos : kText.size();
+    size_t length = 0;
+    const bool kIsValid = Utf8::scanString(pText, data.size() - kOffset, length);
+    ASSERT_EQ(kIsValid, isValidReference(pText, kLength)) << i;
+    if (kIsValid) {
+      ASSERT_EQ(length, kLength) << i;
+    }
+  }
+}
+
+TEST_F(Utf8Test, SequenceAtBlockBoundaryTest)
+{
+  const std::vector<std::string> kChars = {"\xD0\xBF", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+  for (const auto & kChar : kChars) {
+    for (size_t cut = 1; cut <= kChar.size(); ++cut) {
+      for (size_t pos = 0; pos < 70; ++pos) {
+        const std::string kText = std::string(pos, 'a') + kChar.substr(0, cut) + std::string(70, 'b');
+        ASSERT_EQ(isValid(kText), cut == kChar.size()) << pos;
+        size_t length = 0;
+        ASSERT_EQ(Utf8::scanString(reinterpret_cast<const uint8_t *>(kText.c_str()), kText.size() + 1, length),
+                  cut == kChar.size()) << pos;
+      }
+    }
+  }
+}
+
+#ifdef __linux__
+TEST_F(Utf8Test, StringBeforeUnmappedPageTest)
+{
+  const size_t kPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  void * pPages = mmap(nullptr, 2 * kPageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(pPages, MAP_FAILED);
+  uint8_t * pSecondPage = static_cast<uint8_t *>(pPages) + kPageSize;
+  ASSERT_EQ(mprotect(pSecondPage, kPageSize, PROT_NONE), 0);
+  for (size_t size = 1; size <= 100; ++size) {
+    uint8_t * pStr = pSecondPage - size;
+    std::fill(pStr, pSecondPage - 1, static_cast<uint8_t>('a'));
+    pSecondPage[-1] = 0;
+    size_t length = 0;
+    ASSERT_EQ(Utf8::scanString(pStr, std::numeric_limits<size_t>::max() - kPageSize, length), true);
+    ASSERT_EQ(length, size - 1);
+  }
+  munmap(pPages, 2 * kPageSize);
+}
+#endif